@@ -0,0 +1,171 @@
+#include "adaptiverr.h"
+#include <algorithm>
+#include <iomanip>
+
+AdaptiveRRScheduler::AdaptiveRRScheduler(int contextSwitchTime, int latency, int granularity)
+    : Scheduler("Adaptive Round Robin", contextSwitchTime),
+      targetLatency(latency),
+      minGranularity(granularity),
+      timeQuantum(latency),
+      window(),
+      windowCount(0),
+      windowNext(0),
+      medianBurst(0),
+      dispatches(0),
+      quantumSum(0),
+      minQuantum(0),
+      maxQuantum(0) {
+}
+
+void AdaptiveRRScheduler::configure(int latency, int granularity) {
+    targetLatency = latency;
+    minGranularity = granularity;
+    timeQuantum = latency;
+}
+
+void AdaptiveRRScheduler::addProcess(std::shared_ptr<Process> process) {
+    readyQueue.push_back(process);
+    process->setState(ProcessState::READY);
+}
+
+std::shared_ptr<Process> AdaptiveRRScheduler::getNextProcess() {
+    if (readyQueue.empty()) {
+        return nullptr;
+    }
+    
+    auto process = readyQueue.front();
+    readyQueue.pop_front();
+    return process;
+}
+
+bool AdaptiveRRScheduler::shouldPreempt(std::shared_ptr<Process>) {
+    // Like RR, only the end of the time slice preempts
+    return false;
+}
+
+void AdaptiveRRScheduler::updateWaitingTime(int timeElapsed) {
+    // Update waiting time for all processes in the ready queue (in place)
+    for (auto& process : readyQueue) {
+        process->incrementWaitingTime(timeElapsed);
+    }
+}
+
+std::vector<std::shared_ptr<Process>> AdaptiveRRScheduler::getReadyProcesses() const {
+    return std::vector<std::shared_ptr<Process>>(readyQueue.begin(), readyQueue.end());
+}
+
+void AdaptiveRRScheduler::onDispatch(std::shared_ptr<Process>, int time) {
+    // Latency bound: everybody waiting gets a turn within the target latency
+    int waiting = static_cast<int>(readyQueue.size());
+    int latencyBound = std::max(minGranularity, waiting > 0 ? targetLatency / waiting : targetLatency);
+    
+    // Burst bound: a typical recent burst should finish in one slice
+    int quantum = windowCount > 0 ? medianBurst : targetLatency;
+    quantum = std::max(minGranularity, std::min(quantum, latencyBound));
+    
+    if (dispatches == 0 || quantum != timeQuantum) {
+        history.push_back({time, quantum});
+    }
+    timeQuantum = quantum;
+    
+    dispatches++;
+    quantumSum += quantum;
+    minQuantum = dispatches == 1 ? quantum : std::min(minQuantum, quantum);
+    maxQuantum = std::max(maxQuantum, quantum);
+}
+
+void AdaptiveRRScheduler::onCPUBurstComplete(std::shared_ptr<Process>, int burstLength) {
+    window[windowNext] = burstLength;
+    windowNext = (windowNext + 1) % WINDOW;
+    windowCount = std::min(windowCount + 1, WINDOW);
+    
+    // Upper median of the window, O(WINDOW)
+    std::array<int, WINDOW> sorted = window;
+    std::nth_element(sorted.begin(), sorted.begin() + windowCount / 2, sorted.begin() + windowCount);
+    medianBurst = sorted[windowCount / 2];
+}
+
+void AdaptiveRRScheduler::outputAlgorithmResults(std::ostream& out) const {
+    out << "Adaptive Quantum (target latency=" << targetLatency << ", min granularity=" << minGranularity
+        << ", median of last " << WINDOW << " bursts):\n";
+    if (dispatches == 0) {
+        return;
+    }
+    
+    out << "  Dispatches: " << dispatches << ", quantum min/avg/max: " << minQuantum << "/"
+        << std::fixed << std::setprecision(2) << static_cast<double>(quantumSum) / dispatches
+        << "/" << maxQuantum << ", changes: " << history.size() - 1 << "\n";
+    
+    // Quantum over time: the quantum in force at the start of ten equal periods
+    const int PERIODS = 10;
+    out << "  Quantum over time:\n";
+    size_t change = 0;
+    for (int period = 0; period < PERIODS; period++) {
+        int start = static_cast<int>(static_cast<long long>(totalTime) * period / PERIODS);
+        while (change + 1 < history.size() && history[change + 1].first <= start) {
+            change++;
+        }
+        out << "    t=" << std::setw(8) << start << ": " << history[change].second << "\n";
+    }
+}
+
+void AdaptiveRRScheduler::resetPolicyState() {
+    timeQuantum = targetLatency;
+    window.fill(0);
+    windowCount = 0;
+    windowNext = 0;
+    medianBurst = 0;
+    dispatches = 0;
+    quantumSum = 0;
+    minQuantum = 0;
+    maxQuantum = 0;
+    history.clear();
+}
+
+std::vector<double> AdaptiveRRScheduler::getPolicyState() const {
+    // Settings, quantum, burst window, statistics, then the history pairs
+    std::vector<double> state = {static_cast<double>(targetLatency), static_cast<double>(minGranularity),
+                                 static_cast<double>(timeQuantum), static_cast<double>(windowCount),
+                                 static_cast<double>(windowNext), static_cast<double>(medianBurst)};
+    state.insert(state.end(), window.begin(), window.end());
+    state.push_back(static_cast<double>(dispatches));
+    state.push_back(static_cast<double>(quantumSum));
+    state.push_back(minQuantum);
+    state.push_back(maxQuantum);
+    for (const auto& change : history) {
+        state.push_back(change.first);
+        state.push_back(change.second);
+    }
+    return state;
+}
+
+bool AdaptiveRRScheduler::setPolicyState(const std::vector<double>& state) {
+    const size_t FIXED = 6 + WINDOW + 4;
+    if (state.size() < FIXED || (state.size() - FIXED) % 2 != 0) {
+        return false;
+    }
+    
+    targetLatency = static_cast<int>(state[0]);
+    minGranularity = static_cast<int>(state[1]);
+    timeQuantum = static_cast<int>(state[2]);
+    windowCount = static_cast<int>(state[3]);
+    windowNext = static_cast<int>(state[4]);
+    medianBurst = static_cast<int>(state[5]);
+    if (windowCount < 0 || windowCount > WINDOW || windowNext < 0 || windowNext >= WINDOW) {
+        return false;
+    }
+    for (int i = 0; i < WINDOW; i++) {
+        window[i] = static_cast<int>(state[6 + i]);
+    }
+    
+    size_t i = 6 + WINDOW;
+    dispatches = static_cast<long long>(state[i++]);
+    quantumSum = static_cast<long long>(state[i++]);
+    minQuantum = static_cast<int>(state[i++]);
+    maxQuantum = static_cast<int>(state[i++]);
+    history.clear();
+    for (; i < state.size(); i += 2) {
+        history.push_back({static_cast<int>(state[i]), static_cast<int>(state[i + 1])});
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef ADAPTIVERR_H
+#define ADAPTIVERR_H
+
+#include <array>
+#include <deque>
+#include <utility>
+#include "scheduler.h"
+
+// Round Robin with an adaptive time quantum
+// The quantum is recomputed each time a process starts running: it covers
+// the median of the most recent CPU bursts (so a typical burst completes in
+// one slice), but every waiting process must still get a turn within the
+// target latency, and a slice never drops below the minimum granularity.
+//   quantum = clamp(median, minGranularity, max(minGranularity, targetLatency / waiting))
+// CPU-heavy phases with few waiters get long slices and few switches;
+// crowded interactive phases get short slices and low response times.
+class AdaptiveRRScheduler : public Scheduler {
+private:
+    static constexpr int WINDOW = 32;   // Recent bursts in the median
+    
+    std::deque<std::shared_ptr<Process>> readyQueue;
+    int targetLatency;
+    int minGranularity;
+    int timeQuantum;
+    
+    // Ring buffer of recent CPU burst lengths and its median
+    std::array<int, WINDOW> window;
+    int windowCount;
+    int windowNext;
+    int medianBurst;
+    
+    // Quantum statistics and the (time, quantum) history of changes
+    long long dispatches;
+    long long quantumSum;
+    int minQuantum;
+    int maxQuantum;
+    std::vector<std::pair<int, int>> history;
+    
+public:
+    AdaptiveRRScheduler(int contextSwitchTime, int latency, int granularity);
+    
+    // Implementation of abstract methods
+    void addProcess(std::shared_ptr<Process> process) override;
+    std::shared_ptr<Process> getNextProcess() override;
+    bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
+    bool isPreemptive() const override { return true; }
+    void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    size_t getReadyQueueSize() const override { return readyQueue.size(); }
+    int getTimeSlice() const override { return timeQuantum; }
+    
+    // Quantum adaptation and reporting
+    void onDispatch(std::shared_ptr<Process> process, int time) override;
+    void onCPUBurstComplete(std::shared_ptr<Process> process, int burstLength) override;
+    void outputAlgorithmResults(std::ostream& out) const override;
+    void resetPolicyState() override;
+    std::vector<double> getPolicyState() const override;
+    bool setPolicyState(const std::vector<double>& state) override;
+    
+    // Adaptive RR specific methods
+    void configure(int latency, int granularity);
+    int getTimeQuantum() const { return timeQuantum; }
+    const std::vector<std::pair<int, int>>& getQuantumHistory() const { return history; }
+};
+
+#endif // ADAPTIVERR_H
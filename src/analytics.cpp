@@ -0,0 +1,83 @@
+#include "analytics.h"
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+RunAnalytics analyzeRun(const ProcessResultTable& table, int starvationLimit) {
+    RunAnalytics analytics;
+    analytics.processes = static_cast<int>(table.size());
+    analytics.starvationLimit = starvationLimit;
+    if (table.size() == 0) {
+        return analytics;
+    }
+    
+    // Per-process ratios into contiguous arrays first, then the reductions
+    // over them. Both loops are vectorized (built with -fopenmp-simd and
+    // -fno-trapping-math, see the Makefile): the clamps are selects rather
+    // than branches, and the reduction clause lets the sums and maxima be
+    // kept in one partial result per vector lane.
+    size_t count = table.size();
+    const int* service = table.service.data();
+    const int* io = table.io.data();
+    const int* turnaround = table.turnaround.data();
+    const int* waiting = table.waiting.data();
+    std::vector<double> progress(count);
+    std::vector<double> stretch(count);
+    std::vector<double> bounded(count);
+    #pragma omp simd
+    for (size_t i = 0; i < count; i++) {
+        int work = service[i] + io[i];
+        double demand = work > 1 ? work : 1;
+        double elapsed = turnaround[i] > 1 ? turnaround[i] : 1;
+        double bound = work > BOUNDED_SLOWDOWN_THRESHOLD ? work : BOUNDED_SLOWDOWN_THRESHOLD;
+        double slowdown = elapsed / bound;
+        progress[i] = demand / elapsed;
+        stretch[i] = elapsed / demand;
+        bounded[i] = slowdown > 1.0 ? slowdown : 1.0;
+    }
+    
+    double progressSum = 0.0;
+    double progressSquares = 0.0;
+    double stretchSum = 0.0;
+    double stretchMax = 0.0;
+    double boundedSum = 0.0;
+    double boundedMax = 0.0;
+    int starved = 0;
+    #pragma omp simd reduction(+:progressSum, progressSquares, stretchSum, boundedSum, starved) reduction(max:stretchMax, boundedMax)
+    for (size_t i = 0; i < count; i++) {
+        progressSum += progress[i];
+        progressSquares += progress[i] * progress[i];
+        stretchSum += stretch[i];
+        stretchMax = std::max(stretchMax, stretch[i]);
+        boundedSum += bounded[i];
+        boundedMax = std::max(boundedMax, bounded[i]);
+        starved += waiting[i] > starvationLimit;
+    }
+    
+    analytics.jainIndex = progressSum * progressSum / (count * progressSquares);
+    analytics.meanStretch = stretchSum / count;
+    analytics.maxStretch = stretchMax;
+    analytics.meanBoundedSlowdown = boundedSum / count;
+    analytics.maxBoundedSlowdown = boundedMax;
+    analytics.starved = starved;
+    
+    // The process with the largest stretch (first one on ties)
+    size_t worst = std::find(stretch.begin(), stretch.end(), stretchMax) - stretch.begin();
+    analytics.maxStretchProcess = table.ids[worst];
+    return analytics;
+}
+
+void outputAnalytics(std::ostream& out, const RunAnalytics& analytics) {
+    if (analytics.processes == 0) return;
+    
+    out << "Fairness and Slowdown (" << analytics.processes << " processes):\n"
+        << std::fixed << std::setprecision(4)
+        << "  Jain's Fairness Index (progress rates): " << analytics.jainIndex << "\n"
+        << std::setprecision(2)
+        << "  Bounded Slowdown (threshold=" << BOUNDED_SLOWDOWN_THRESHOLD << "): mean "
+        << analytics.meanBoundedSlowdown << ", max " << analytics.maxBoundedSlowdown << "\n"
+        << "  Stretch: mean " << analytics.meanStretch << ", max " << analytics.maxStretch
+        << " (process " << analytics.maxStretchProcess << ")\n"
+        << "  Starved (waited > " << analytics.starvationLimit << "): " << analytics.starved << " ("
+        << 100.0 * analytics.starved / analytics.processes << "%)\n\n";
+}
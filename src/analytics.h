@@ -0,0 +1,36 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <iostream>
+#include "resultwriter.h"
+
+// Demand below which slowdown is measured against this floor instead, so
+// very short processes do not dominate the slowdown figures
+const int BOUNDED_SLOWDOWN_THRESHOLD = 10;
+
+// Fairness and slowdown of one run, for comparing policies against SLOs.
+// A process's demand is its CPU plus I/O time (its turnaround alone on the
+// machine) and its stretch is turnaround / demand. Jain's index is taken over
+// the progress rates demand / turnaround: 1 when every process was slowed
+// down alike, 1/n when one process got all the progress. Bounded slowdown is
+// turnaround / max(demand, BOUNDED_SLOWDOWN_THRESHOLD), at least 1. A process
+// is starved when its total wait in the ready queue exceeds the limit.
+struct RunAnalytics {
+    int processes = 0;
+    double jainIndex = 0.0;
+    double meanBoundedSlowdown = 0.0;
+    double maxBoundedSlowdown = 0.0;
+    double meanStretch = 0.0;
+    double maxStretch = 0.0;
+    int maxStretchProcess = 0;
+    int starvationLimit = 0;
+    int starved = 0;
+};
+
+// Two vectorized passes over the table's contiguous columns: per-process
+// ratios, then their sums and maxima
+RunAnalytics analyzeRun(const ProcessResultTable& table, int starvationLimit);
+
+void outputAnalytics(std::ostream& out, const RunAnalytics& analytics);
+
+#endif // ANALYTICS_H
@@ -0,0 +1,207 @@
+#include "batch.h"
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "parser.h"
+#include "threadpool.h"
+
+namespace fs = std::filesystem;
+
+BatchRunner::BatchRunner(const SimulationParams& simulationParams)
+    : params(simulationParams),
+      nextToWrite(0),
+      inFlight(0),
+      failedWorkloads(0) {
+    
+    if (params.algorithm == "ALL") {
+        algorithms = Simulator::algorithmNames();
+    } else {
+        algorithms = {params.algorithm};
+    }
+    
+    // Batch jobs never trace or print per-process details
+    params.verboseMode = false;
+    params.detailedMode = false;
+}
+
+bool BatchRunner::listWorkloads(std::vector<std::string>& paths) const {
+    std::error_code error;
+    
+    if (fs::is_directory(params.batchInput, error)) {
+        for (const auto& entry : fs::directory_iterator(params.batchInput, error)) {
+            if (entry.is_regular_file()) {
+                paths.push_back(entry.path().string());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        return !error;
+    }
+    
+    std::ifstream manifest(params.batchInput);
+    if (!manifest) {
+        std::cerr << "Error: Cannot open manifest " << params.batchInput << std::endl;
+        return false;
+    }
+    
+    // Relative entries are resolved against the manifest's directory
+    fs::path base = fs::path(params.batchInput).parent_path();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+        size_t end = line.find_last_not_of(" \t\r");
+        fs::path entry = line.substr(start, end - start + 1);
+        paths.push_back(entry.is_absolute() ? entry.string() : (base / entry).string());
+    }
+    
+    return true;
+}
+
+bool BatchRunner::run() {
+    std::vector<std::string> paths;
+    if (!listWorkloads(paths)) {
+        return false;
+    }
+    
+    // Large output buffer: rows are short and there may be millions of them
+    outputBuffer.resize(1 << 20);
+    output.rdbuf()->pubsetbuf(outputBuffer.data(), outputBuffer.size());
+    output.open(params.batchOutput);
+    if (!output) {
+        std::cerr << "Error: Cannot open results file " << params.batchOutput << std::endl;
+        return false;
+    }
+    
+    output << "workload,algorithm,status,processes,context_switch_time,total_time,"
+              "cpu_utilization,context_switches,avg_turnaround,avg_waiting\n";
+    
+    ThreadPool pool(params.threads);
+    const size_t window = 2 * pool.getThreadCount();
+    
+    for (size_t index = 0; index < paths.size(); index++) {
+        {
+            std::unique_lock<std::mutex> lock(resultsMutex);
+            windowAvailable.wait(lock, [this, window] { return inFlight < window; });
+            inFlight++;
+            pending[index].rows.resize(algorithms.size());
+            pending[index].remaining = algorithms.size();
+        }
+        
+        const std::string& path = paths[index];
+        pool.submit([this, index, &path, &pool] { loadWorkload(index, path, pool); });
+    }
+    
+    pool.wait();
+    output.flush();
+    
+    std::cerr << "Batch: " << paths.size() << " workloads x " << algorithms.size()
+              << " algorithms written to " << params.batchOutput;
+    if (failedWorkloads > 0) {
+        std::cerr << " (" << failedWorkloads << " workloads failed to parse or are unsupported)";
+    }
+    std::cerr << std::endl;
+    
+    return true;
+}
+
+void BatchRunner::loadWorkload(size_t index, const std::string& path, ThreadPool& pool) {
+    auto workload = std::make_shared<Workload>();
+    auto cgroups = std::make_shared<CgroupHierarchy>();
+    Topology topology;
+    
+    std::ifstream input(path);
+    Parser parser(input);
+    std::string status;
+    if (!input || !parser.parse(workload->processes, workload->contextSwitchTime, topology, *cgroups,
+                                workload->memory)) {
+        std::cerr << "Error: Failed to parse workload " << path << std::endl;
+        status = "parse_error";
+    } else if (topology.isDefined()) {
+        // A topology makes the input a multi-core workload
+        std::cerr << "Error: Batch mode does not run the multi-core model of workload " << path << std::endl;
+        status = "unsupported";
+    }
+    
+    if (!status.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            failedWorkloads++;
+        }
+        for (size_t slot = 0; slot < algorithms.size(); slot++) {
+            storeRow(index, slot, path + "," + algorithms[slot] + "," + status + ",,,,,,,");
+        }
+        return;
+    }
+    if (!cgroups->empty()) {
+        workload->cgroups = cgroups;
+    }
+    
+    // One job per algorithm; they share the parsed workload and copy its processes
+    for (size_t slot = 0; slot < algorithms.size(); slot++) {
+        pool.submit([this, index, slot, &path, workload] {
+            storeRow(index, slot, runJob(path, algorithms[slot], *workload));
+        });
+    }
+}
+
+std::string BatchRunner::runJob(const std::string& path, const std::string& algorithm,
+                                const Workload& workload) const {
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(workload.processes.size());
+    for (const auto& process : workload.processes) {
+        processes.push_back(std::make_shared<Process>(*process));
+    }
+    
+    Simulator simulator(workload.contextSwitchTime);
+    simulator.initialize(processes);
+    
+    SimulationParams jobParams = params;
+    jobParams.algorithm = algorithm;
+    simulator.setParams(jobParams);
+    if (workload.cgroups) {
+        simulator.setCgroups(workload.cgroups);
+    }
+    simulator.setMemory(workload.memory);
+    simulator.run();
+    
+    RunSummary summary = simulator.summarize();
+    
+    std::ostringstream row;
+    row << path << "," << algorithm << ",ok," << summary.processes << ","
+        << workload.contextSwitchTime << "," << summary.totalTime << ","
+        << std::fixed << std::setprecision(2) << summary.cpuUtilization << ","
+        << summary.contextSwitches << ","
+        << summary.avgTurnaround << "," << summary.avgWaiting;
+    return row.str();
+}
+
+void BatchRunner::storeRow(size_t index, size_t slot, const std::string& row) {
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    
+    WorkloadRows& entry = pending[index];
+    entry.rows[slot] = row;
+    entry.remaining--;
+    
+    if (entry.remaining == 0 && index == nextToWrite) {
+        flushCompleted();
+    }
+}
+
+void BatchRunner::flushCompleted() {
+    // Caller holds resultsMutex; write finished workloads in input order
+    auto it = pending.find(nextToWrite);
+    while (it != pending.end() && it->second.remaining == 0) {
+        for (const auto& row : it->second.rows) {
+            output << row << "\n";
+        }
+        pending.erase(it);
+        nextToWrite++;
+        inFlight--;
+        it = pending.find(nextToWrite);
+    }
+    windowAvailable.notify_all();
+}
@@ -0,0 +1,65 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "process.h"
+#include "simulator.h"
+
+// Batch runner: simulates every workload of a manifest (one path per line) or
+// directory against every selected algorithm on a work-stealing thread pool.
+// At most a fixed window of workloads is parsed and in flight at a time, and
+// finished workloads are flushed to the results file in input order, so
+// memory stays bounded however many workloads the corpus holds. Workloads
+// run as "sim < file" would, with their cgroups and host memory; those
+// declaring a topology (the multi-core model) get unsupported rows instead.
+class BatchRunner {
+private:
+    // Parsed workload shared (read-only) by its algorithm jobs, with the
+    // control groups and host memory its header declares
+    struct Workload {
+        std::vector<std::shared_ptr<Process>> processes;
+        int contextSwitchTime;
+        std::shared_ptr<const CgroupHierarchy> cgroups;     // nullptr = none
+        MemoryConfig memory;
+    };
+    
+    // Result rows of one workload, one per algorithm
+    struct WorkloadRows {
+        std::vector<std::string> rows;
+        size_t remaining;
+    };
+    
+    SimulationParams params;
+    std::vector<std::string> algorithms;
+    
+    std::ofstream output;
+    std::vector<char> outputBuffer;
+    
+    std::mutex resultsMutex;
+    std::condition_variable windowAvailable;
+    std::map<size_t, WorkloadRows> pending;   // Workloads in flight, by input index
+    size_t nextToWrite;
+    size_t inFlight;
+    size_t failedWorkloads;
+    
+    bool listWorkloads(std::vector<std::string>& paths) const;
+    void loadWorkload(size_t index, const std::string& path, class ThreadPool& pool);
+    std::string runJob(const std::string& path, const std::string& algorithm,
+                       const Workload& workload) const;
+    void storeRow(size_t index, size_t slot, const std::string& row);
+    void flushCompleted();
+    
+public:
+    BatchRunner(const SimulationParams& simulationParams);
+    
+    // Run the whole batch; returns false if the batch could not be set up
+    bool run();
+};
+
+#endif // BATCH_H
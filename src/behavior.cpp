@@ -0,0 +1,60 @@
+#include "behavior.h"
+
+BurstBehavior::BurstBehavior(const std::vector<BehaviorPhase>& behaviorPhases, unsigned long long behaviorSeed,
+                             int stretchPercent)
+    : phases(behaviorPhases), seed(behaviorSeed), cpuStretch(stretchPercent) {
+}
+
+bool BurstBehavior::isValid(const std::vector<BehaviorPhase>& behaviorPhases) {
+    if (behaviorPhases.empty()) {
+        return false;
+    }
+    for (const auto& phase : behaviorPhases) {
+        if (phase.length <= 0 || phase.minCPU <= 0 || phase.maxCPU < phase.minCPU ||
+            phase.minIO <= 0 || phase.maxIO < phase.minIO) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BehaviorState BurstBehavior::start() const {
+    BehaviorState state;
+    state.rng = seed;
+    state.phase = 0;
+    state.phaseRemaining = phases.front().length;
+    return state;
+}
+
+int BurstBehavior::draw(BehaviorState& state, int low, int high) {
+    // splitmix64 step
+    state.rng += 0x9E3779B97F4A7C15ULL;
+    unsigned long long z = state.rng;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    
+    unsigned long long span = static_cast<unsigned long long>(high - low) + 1;
+    return low + static_cast<int>(z % span);
+}
+
+int BurstBehavior::nextCPUBurst(BehaviorState& state) const {
+    if (state.phaseRemaining == 0) {
+        state.phase = (state.phase + 1) % static_cast<int>(phases.size());
+        state.phaseRemaining = phases[state.phase].length;
+    }
+    state.phaseRemaining--;
+    
+    const BehaviorPhase& phase = phases[state.phase];
+    int duration = draw(state, phase.minCPU, phase.maxCPU);
+    return cpuStretch > 0 ? (duration * (100 + cpuStretch) + 99) / 100 : duration;
+}
+
+int BurstBehavior::nextIOBurst(BehaviorState& state) const {
+    const BehaviorPhase& phase = phases[state.phase];
+    return draw(state, phase.minIO, phase.maxIO);
+}
+
+std::shared_ptr<const BurstBehavior> BurstBehavior::stretched(int percent) const {
+    return std::make_shared<BurstBehavior>(phases, seed, percent);
+}
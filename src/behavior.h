@@ -0,0 +1,62 @@
+#ifndef BEHAVIOR_H
+#define BEHAVIOR_H
+
+#include <memory>
+#include <vector>
+
+// Limits of procedural processes read from input
+const int MAX_BEHAVIOR_PHASES = 64;
+const int MAX_BEHAVIOR_BURSTS = 1000000000;
+
+// One phase of a burst behavior: 'length' CPU bursts drawn uniformly from
+// [minCPU, maxCPU], each followed by an I/O burst from [minIO, maxIO]
+struct BehaviorPhase {
+    int length;
+    int minCPU;
+    int maxCPU;
+    int minIO;
+    int maxIO;
+};
+
+// Position of one process in its behavior; a few words, copied with the process
+struct BehaviorState {
+    unsigned long long rng;
+    int phase;
+    int phaseRemaining;     // CPU bursts left in the current phase
+};
+
+// Procedural burst behavior: instead of storing its burst list, a process
+// draws every burst when it reaches it, cycling through the phases (a single
+// phase is a plain distribution). Behaviors are immutable and shared by all
+// copies of a process; the same seed always yields the same bursts.
+class BurstBehavior {
+private:
+    std::vector<BehaviorPhase> phases;
+    unsigned long long seed;
+    int cpuStretch;         // Percent added to every CPU burst (NUMA remote execution)
+    
+    static int draw(BehaviorState& state, int low, int high);
+    
+public:
+    BurstBehavior(const std::vector<BehaviorPhase>& behaviorPhases, unsigned long long behaviorSeed,
+                  int stretchPercent = 0);
+    
+    // Checks phase lengths and burst ranges
+    static bool isValid(const std::vector<BehaviorPhase>& behaviorPhases);
+    
+    // State before the first burst
+    BehaviorState start() const;
+    
+    // Next CPU burst, then the I/O burst that follows it (same phase)
+    int nextCPUBurst(BehaviorState& state) const;
+    int nextIOBurst(BehaviorState& state) const;
+    
+    // Same draws with CPU bursts 'percent' longer
+    std::shared_ptr<const BurstBehavior> stretched(int percent) const;
+    
+    const std::vector<BehaviorPhase>& getPhases() const { return phases; }
+    unsigned long long getSeed() const { return seed; }
+    int getCPUStretch() const { return cpuStretch; }
+};
+
+#endif // BEHAVIOR_H
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "process.h"
+#include "simulator.h"
+
+// Bursty workload: processes arrive in waves that share a timestamp, and I/O
+// times are multiples of a coarse tick so completions cluster as well
+static std::vector<std::shared_ptr<Process>> buildBurstyWorkload(int waves, int processesPerWave, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> burstCountDist(2, 8);
+    std::uniform_int_distribution<> cpuBurstDist(1, 20);
+    std::uniform_int_distribution<> ioTickDist(1, 10);
+    
+    const int WAVE_INTERVAL = 20000;
+    const int IO_TICK = 50;
+    
+    std::vector<std::shared_ptr<Process>> processes;
+    int pid = 1;
+    
+    for (int wave = 0; wave < waves; wave++) {
+        for (int i = 0; i < processesPerWave; i++) {
+            auto process = std::make_shared<Process>(pid++, wave * WAVE_INTERVAL);
+            int numBursts = burstCountDist(gen);
+            
+            for (int j = 0; j < numBursts; j++) {
+                process->addCPUBurst(cpuBurstDist(gen));
+                if (j < numBursts - 1) {
+                    process->addIOBurst(ioTickDist(gen) * IO_TICK);
+                }
+            }
+            processes.push_back(process);
+        }
+    }
+    
+    return processes;
+}
+
+// CPU-bound workload for the proportional-share comparison: one long burst
+// per process, all arriving at time 0, tickets cycling through 10..100
+static std::vector<std::shared_ptr<Process>> buildShareWorkload(int numProcesses) {
+    std::vector<std::shared_ptr<Process>> processes;
+    for (int i = 0; i < numProcesses; i++) {
+        auto process = std::make_shared<Process>(i + 1, 0);
+        process->addCPUBurst(1000000000);
+        process->setTickets(10 * (1 + i % 10));
+        processes.push_back(process);
+    }
+    return processes;
+}
+
+// Share accuracy and dispatch cost of lottery and stride scheduling against
+// Round Robin (which ignores tickets) at growing process counts
+static int runShareBench(int maxProcesses) {
+    const int QUANTUM = 10;
+    const int ROUNDS = 100;
+    const std::string algorithms[] = {"RR10", "LOTTERY", "STRIDE"};
+    
+    std::cout << "Proportional share: CPU-bound processes, tickets 10..100, "
+              << ROUNDS << " quanta of " << QUANTUM << " per process\n\n";
+    std::cout << std::left << std::setw(9) << "Algo" << std::right << std::setw(8) << "Procs"
+              << std::setw(14) << "MeanErr(%)" << std::setw(14) << "MaxErr(%)"
+              << std::setw(14) << "Run(ms)" << std::setw(14) << "Dispatch(ns)" << "\n";
+    
+    for (int numProcesses : {100, maxProcesses / 4, maxProcesses}) {
+        auto processes = buildShareWorkload(numProcesses);
+        long long totalTickets = 0;
+        for (const auto& process : processes) {
+            totalTickets += process->getTickets();
+        }
+        
+        for (const auto& algorithm : algorithms) {
+            // Share accuracy: CPU time received vs. ticket share, no switch cost
+            Simulator simulator(0);
+            simulator.initialize(processes);
+            SimulationParams params;
+            params.algorithm = algorithm;
+            simulator.setParams(params);
+            
+            auto start = std::chrono::steady_clock::now();
+            simulator.start();
+            simulator.runUntil(numProcesses * QUANTUM * ROUNDS);
+            auto end = std::chrono::steady_clock::now();
+            double runMs = std::chrono::duration<double, std::milli>(end - start).count();
+            
+            long long totalReceived = 0;
+            for (const auto& process : processes) {
+                totalReceived += process->getCurrentBurstElapsed();
+            }
+            double meanError = 0.0;
+            double maxError = 0.0;
+            for (const auto& process : processes) {
+                double target = static_cast<double>(process->getTickets()) / totalTickets;
+                double actual = static_cast<double>(process->getCurrentBurstElapsed()) / totalReceived;
+                double error = 100.0 * std::fabs(actual - target) / target;
+                meanError += error / numProcesses;
+                maxError = std::max(maxError, error);
+            }
+            
+            // Dispatch cost: pick the next process and put it back, with all processes ready
+            auto scheduler = Simulator::createScheduler(algorithm, 0);
+            for (const auto& process : processes) {
+                scheduler->addProcess(process);
+            }
+            const int OPERATIONS = 200000;
+            start = std::chrono::steady_clock::now();
+            for (int i = 0; i < OPERATIONS; i++) {
+                scheduler->addProcess(scheduler->getNextProcess());
+            }
+            end = std::chrono::steady_clock::now();
+            double dispatchNs = std::chrono::duration<double, std::nano>(end - start).count() / OPERATIONS;
+            
+            std::cout << std::left << std::setw(9) << algorithm << std::right << std::setw(8) << numProcesses
+                      << std::fixed << std::setprecision(2) << std::setw(14) << meanError
+                      << std::setw(14) << maxError << std::setw(14) << runMs
+                      << std::setw(14) << dispatchNs << "\n";
+        }
+    }
+    
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "share") {
+        return runShareBench(argc > 2 ? std::stoi(argv[2]) : 2000);
+    }
+    
+    int waves = 20;
+    int processesPerWave = 100;
+    
+    if (argc > 1) waves = std::stoi(argv[1]);
+    if (argc > 2) processesPerWave = std::stoi(argv[2]);
+    
+    const int CONTEXT_SWITCH_TIME = 5;
+    const std::string algorithms[] = {"FCFS", "SJF", "SRTN", "RR10", "RR50", "RR100"};
+    
+    auto processes = buildBurstyWorkload(waves, processesPerWave, 42);
+    
+    std::cout << "Bursty workload: " << waves << " waves x " << processesPerWave
+              << " processes (" << processes.size() << " total)\n\n";
+    std::cout << std::left << std::setw(8) << "Algo" << std::setw(8) << "Mode"
+              << std::right << std::setw(12) << "Time(ms)" << std::setw(12) << "Events"
+              << std::setw(12) << "Decisions" << std::setw(12) << "Switches"
+              << std::setw(12) << "Finish" << std::setw(10) << "Speedup" << "\n";
+    
+    for (const auto& algorithm : algorithms) {
+        double perEventMs = 0.0;
+        
+        for (bool batch : {false, true}) {
+            // Best of several repetitions to keep timer noise out of the comparison
+            const int REPETITIONS = 3;
+            double ms = 0.0;
+            long long events = 0;
+            long long decisions = 0;
+            int switches = 0;
+            int finish = 0;
+            
+            for (int rep = 0; rep < REPETITIONS; rep++) {
+                Simulator simulator(CONTEXT_SWITCH_TIME);
+                simulator.initialize(processes);
+                
+                SimulationParams params;
+                params.algorithm = algorithm;
+                params.batchEvents = batch;
+                simulator.setParams(params);
+                
+                auto start = std::chrono::steady_clock::now();
+                simulator.run();
+                auto end = std::chrono::steady_clock::now();
+                double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+                
+                if (rep == 0 || elapsed < ms) {
+                    ms = elapsed;
+                }
+                events = simulator.getProcessedEvents();
+                decisions = simulator.getDispatchDecisions();
+                switches = simulator.getActiveScheduler()->getContextSwitchCount();
+                finish = simulator.getActiveScheduler()->getTotalTime();
+            }
+            
+            std::cout << std::left << std::setw(8) << algorithm << std::setw(8) << (batch ? "batch" : "event")
+                      << std::right << std::fixed << std::setprecision(2) << std::setw(12) << ms
+                      << std::setw(12) << events << std::setw(12) << decisions
+                      << std::setw(12) << switches << std::setw(12) << finish;
+            
+            if (batch) {
+                std::cout << std::setw(9) << (ms > 0.0 ? perEventMs / ms : 0.0) << "x";
+            } else {
+                perEventMs = ms;
+            }
+            std::cout << "\n";
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include "cgroup.h"
+#include <algorithm>
+#include <climits>
+#include <iomanip>
+#include <sstream>
+
+bool CgroupHierarchy::add(int id, int parentId, int weight, int quota, int period) {
+    if (groups.size() >= static_cast<size_t>(MAX_CGROUPS)) {
+        std::cerr << "Error: At most " << MAX_CGROUPS << " cgroups are supported" << std::endl;
+        return false;
+    }
+    if (id <= 0 || indexes.count(id)) {
+        std::cerr << "Error: Invalid or duplicate cgroup ID " << id << std::endl;
+        return false;
+    }
+    if (!contains(parentId)) {
+        std::cerr << "Error: Parent " << parentId << " of cgroup " << id << " must be declared before it" << std::endl;
+        return false;
+    }
+    if (weight < 1 || weight > MAX_CGROUP_WEIGHT || quota < 0 || period < 1) {
+        std::cerr << "Error: cgroup " << id << " needs a weight in 1.." << MAX_CGROUP_WEIGHT
+                  << ", a quota >= 0 and a period >= 1" << std::endl;
+        return false;
+    }
+    
+    int parent = indexOf(parentId);
+    int depth = parent < 0 ? 1 : groups[parent].depth + 1;
+    indexes[id] = static_cast<int>(groups.size());
+    groups.push_back({id, parent, weight, quota, period, depth});
+    return true;
+}
+
+int CgroupHierarchy::indexOf(int id) const {
+    auto it = indexes.find(id);
+    return it != indexes.end() ? it->second : -1;
+}
+
+CgroupAccounting::CgroupAccounting(std::shared_ptr<const CgroupHierarchy> groups)
+    : hierarchy(groups), states(groups ? groups->size() : 0), rootUsage(0) {
+}
+
+int CgroupAccounting::remaining(int group, int time) const {
+    const auto& spec = hierarchy->at(group);
+    if (spec.quota == 0) {
+        return INT_MAX;
+    }
+    return states[group].period == time / spec.period ? spec.quota - states[group].used : spec.quota;
+}
+
+void CgroupAccounting::charge(int group, int from, int to) {
+    if (to <= from) return;
+    rootUsage += to - from;
+    
+    for (int g = group; g >= 0; g = hierarchy->at(g).parent) {
+        const auto& spec = hierarchy->at(g);
+        State& state = states[g];
+        state.usage += to - from;
+        if (spec.quota == 0) continue;
+        
+        // Only the part in the period of the last time unit counts against the quota
+        long long period = (to - 1) / spec.period;
+        long long periodStart = period * spec.period;
+        if (state.period != period) {
+            state.period = period;
+            state.used = 0;
+        }
+        state.used += static_cast<int>(to - std::max<long long>(from, periodStart));
+    }
+}
+
+int CgroupAccounting::quotaHorizon(int group, int time) const {
+    int horizon = -1;
+    for (int g = group; g >= 0; g = hierarchy->at(g).parent) {
+        const auto& spec = hierarchy->at(g);
+        if (spec.quota == 0) continue;
+        
+        int limit = std::min(remaining(g, time), refillTime(g, time) - time);
+        horizon = horizon < 0 ? limit : std::min(horizon, limit);
+    }
+    return horizon < 0 ? -1 : std::max(horizon, 0);
+}
+
+std::vector<int> CgroupAccounting::throttleExhausted(int group, int time) {
+    std::vector<int> throttled;
+    for (int g = group; g >= 0; g = hierarchy->at(g).parent) {
+        State& state = states[g];
+        if (hierarchy->at(g).quota > 0 && !state.throttled && remaining(g, time) <= 0) {
+            state.throttled = true;
+            state.throttledSince = time;
+            state.throttles++;
+            throttled.push_back(g);
+        }
+    }
+    return throttled;
+}
+
+int CgroupAccounting::throttledAncestor(int group) const {
+    int highest = -1;
+    for (int g = group; g >= 0; g = hierarchy->at(g).parent) {
+        if (states[g].throttled) {
+            highest = g;
+        }
+    }
+    return highest;
+}
+
+int CgroupAccounting::refillTime(int group, int time) const {
+    int period = hierarchy->at(group).period;
+    return (time / period + 1) * period;
+}
+
+void CgroupAccounting::unthrottle(int group, int time) {
+    State& state = states[group];
+    if (!state.throttled) return;
+    state.throttled = false;
+    state.throttledTime += time - state.throttledSince;
+}
+
+void CgroupAccounting::finish(int time) {
+    for (size_t g = 0; g < states.size(); g++) {
+        unthrottle(static_cast<int>(g), time);
+    }
+}
+
+std::vector<long long> CgroupAccounting::getState() const {
+    // Root usage, then seven values per group
+    std::vector<long long> state = {rootUsage};
+    for (const auto& group : states) {
+        state.insert(state.end(), {group.usage, group.period, group.used, group.throttled ? 1 : 0,
+                                   group.throttledSince, group.throttledTime, group.throttles});
+    }
+    return state;
+}
+
+bool CgroupAccounting::setState(const std::vector<long long>& state) {
+    if (state.size() != 1 + 7 * states.size()) {
+        return false;
+    }
+    
+    rootUsage = state[0];
+    size_t i = 1;
+    for (auto& group : states) {
+        group.usage = state[i++];
+        group.period = state[i++];
+        group.used = static_cast<int>(state[i++]);
+        group.throttled = state[i++] != 0;
+        group.throttledSince = static_cast<int>(state[i++]);
+        group.throttledTime = state[i++];
+        group.throttles = static_cast<int>(state[i++]);
+    }
+    return true;
+}
+
+void CgroupAccounting::output(std::ostream& out, int totalTime) const {
+    if (!hierarchy || hierarchy->empty()) return;
+    
+    out << "Cgroups (CPU time of each subtree):\n"
+        << "    Group  Parent  Weight  Quota/Period    CPU Time   Share  Throttles  Throttled Time\n";
+    auto row = [&](const std::string& group, const std::string& parent, const std::string& weight,
+                   const std::string& limit, long long usage, const std::string& throttles,
+                   const std::string& throttled) {
+        out << std::setw(9) << group << std::setw(8) << parent << std::setw(8) << weight << std::setw(14) << limit
+            << std::setw(12) << usage << std::setw(7) << std::fixed << std::setprecision(1)
+            << (totalTime > 0 ? 100.0 * usage / totalTime : 0.0) << "%" << std::setw(11) << throttles
+            << std::setw(16) << throttled << "\n";
+    };
+    
+    row("root", "-", "-", "max", rootUsage, "-", "-");
+    for (size_t g = 0; g < states.size(); g++) {
+        const auto& spec = hierarchy->at(static_cast<int>(g));
+        std::ostringstream limit;
+        if (spec.quota > 0) {
+            limit << spec.quota;
+        } else {
+            limit << "max";
+        }
+        limit << "/" << spec.period;
+        
+        row(std::to_string(spec.id), spec.parent < 0 ? "root" : std::to_string(hierarchy->at(spec.parent).id),
+            std::to_string(spec.weight), limit.str(), states[g].usage, std::to_string(states[g].throttles),
+            std::to_string(states[g].throttledTime));
+    }
+    out << "\n";
+}
@@ -0,0 +1,102 @@
+#ifndef CGROUP_H
+#define CGROUP_H
+
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Largest control group hierarchy and the range of group weights
+const int MAX_CGROUPS = 4096;
+const int MAX_CGROUP_WEIGHT = 10000;
+
+// Control group hierarchy declared in the input: cgroups=K on the header
+// line, then one "id parent weight quota period" line per group, parents
+// before their children (parent 0 is the root). A group's processes and
+// subgroups share its weight against its siblings, and the whole subtree may
+// use at most 'quota' CPU time per 'period' (quota 0 = unlimited), as with
+// cpu.weight and cpu.max. Processes join a group with cgroup=ID.
+class CgroupHierarchy {
+public:
+    struct Group {
+        int id;
+        int parent;          // Index of the parent group (-1 = root)
+        int weight;
+        int quota;           // CPU time per period (0 = unlimited)
+        int period;
+        int depth;           // 1 for children of the root
+    };
+    
+private:
+    std::vector<Group> groups;
+    std::unordered_map<int, int> indexes;   // Group ID -> index
+    
+public:
+    // Append a group; reports invalid groups on std::cerr
+    bool add(int id, int parentId, int weight, int quota, int period);
+    
+    bool empty() const { return groups.empty(); }
+    size_t size() const { return groups.size(); }
+    const Group& at(int index) const { return groups[index]; }
+    
+    // Index of a group ID (-1 = the root, also for unknown IDs)
+    int indexOf(int id) const;
+    bool contains(int id) const { return id == 0 || indexes.count(id) > 0; }
+};
+
+// CPU accounting and bandwidth throttling of one run over a hierarchy.
+// Usage is charged to a group and all its ancestors, and quota checks walk
+// the same path, so both cost O(depth). Quota use is kept for the current
+// period only and restarts lazily when a charge falls into a new period.
+class CgroupAccounting {
+private:
+    struct State {
+        long long usage = 0;             // CPU time of the subtree
+        long long period = -1;           // Period 'used' belongs to
+        int used = 0;                    // Quota used in that period
+        bool throttled = false;
+        int throttledSince = 0;
+        long long throttledTime = 0;
+        int throttles = 0;
+    };
+    
+    std::shared_ptr<const CgroupHierarchy> hierarchy;
+    std::vector<State> states;
+    long long rootUsage;
+    
+    // Quota left to the group in the period containing 'time'
+    int remaining(int group, int time) const;
+    
+public:
+    CgroupAccounting(std::shared_ptr<const CgroupHierarchy> groups = nullptr);
+    
+    // Charge the CPU time [from, to) of a process in 'group' (-1 = root)
+    void charge(int group, int from, int to);
+    
+    // How long a process of 'group' may run from 'time' before its quotas
+    // need another look: until a quota runs out or a period ends on the path
+    // (-1 = no quota on the path)
+    int quotaHorizon(int group, int time) const;
+    
+    // Throttle the groups on the path whose quota is used up for the period
+    // containing 'time'; returns the newly throttled groups
+    std::vector<int> throttleExhausted(int group, int time);
+    
+    // Highest throttled group on the path (-1 = none)
+    int throttledAncestor(int group) const;
+    
+    // Start of the next period of a group, when its quota comes back
+    int refillTime(int group, int time) const;
+    void unthrottle(int group, int time);
+    
+    // Close the throttled intervals still open at the end of a run
+    void finish(int time);
+    
+    // Checkpoint support (in-memory forks)
+    std::vector<long long> getState() const;
+    bool setState(const std::vector<long long>& state);
+    
+    void output(std::ostream& out, int totalTime) const;
+};
+
+#endif // CGROUP_H
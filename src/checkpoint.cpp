@@ -0,0 +1,306 @@
+#include "checkpoint.h"
+#include <algorithm>
+#include <iomanip>
+#include "threadpool.h"
+
+namespace {
+    const char* const CHECKPOINT_MAGIC = "CPUSIM-CHECKPOINT";
+    const int CHECKPOINT_VERSION = 6;
+    
+    bool expectKeyword(std::istream& in, const std::string& keyword) {
+        std::string word;
+        if (!(in >> word) || word != keyword) {
+            std::cerr << "Error: Malformed checkpoint, expected '" << keyword << "'" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    // No list in a checkpoint may claim more entries than this. Lists grow
+    // as their entries are read, so a corrupt count allocates nothing ahead.
+    const long long MAX_CHECKPOINT_ENTRIES = 100000000;
+    const size_t MAX_RESERVE = 4096;
+    
+    bool readCount(std::istream& in, const std::string& what, size_t& count) {
+        long long value = -1;
+        if (!(in >> value)) {
+            std::cerr << "Error: Malformed checkpoint, expected the " << what << " count" << std::endl;
+            return false;
+        }
+        if (value < 0 || value > MAX_CHECKPOINT_ENTRIES) {
+            std::cerr << "Error: Invalid " << what << " count " << value << " in checkpoint" << std::endl;
+            return false;
+        }
+        count = static_cast<size_t>(value);
+        return true;
+    }
+    
+    template <typename T>
+    bool readList(std::istream& in, const std::string& what, std::vector<T>& values) {
+        size_t count = 0;
+        if (!readCount(in, what, count)) return false;
+        values.clear();
+        values.reserve(std::min(count, MAX_RESERVE));
+        for (size_t i = 0; i < count; i++) {
+            T value;
+            if (!(in >> value)) {
+                std::cerr << "Error: Checkpoint ends inside the " << what << " list" << std::endl;
+                return false;
+            }
+            values.push_back(value);
+        }
+        return true;
+    }
+}
+
+bool writeSnapshot(const SimulationSnapshot& snapshot, std::ostream& out) {
+    if (snapshot.cgroups && !snapshot.cgroups->empty()) {
+        std::cerr << "Error: Checkpoint files cannot hold a cgroup hierarchy" << std::endl;
+        return false;
+    }
+    
+    out << CHECKPOINT_MAGIC << " " << CHECKPOINT_VERSION << "\n"
+        << "algorithm " << snapshot.algorithm << "\n"
+        << "clock " << snapshot.currentTime << " " << snapshot.processSwitchTime << " "
+        << snapshot.switchInProgress << " " << snapshot.runStartTime << " "
+        << snapshot.runningTag << " " << snapshot.nextTag << " "
+        << snapshot.processedEvents << " " << snapshot.dispatchDecisions << "\n"
+        << "switchcost " << snapshot.switchCostSpec << "\n"
+        << "scheduler " << snapshot.cpuBusyTime << " " << snapshot.contextSwitchCount << " "
+        << snapshot.currentPid << " " << snapshot.timeQuantum << " " << snapshot.currentTimeSlice << "\n";
+    
+    out << "ready " << snapshot.readyPids.size();
+    for (int pid : snapshot.readyPids) {
+        out << " " << pid;
+    }
+    out << "\n";
+    
+    // Scheduler policy state, written with enough digits to round-trip
+    out << "policy " << snapshot.policyState.size() << std::setprecision(17);
+    for (double value : snapshot.policyState) {
+        out << " " << value;
+    }
+    out << "\n";
+    
+    out << "overhead " << snapshot.switchBreakdown.size();
+    for (long long value : snapshot.switchBreakdown) {
+        out << " " << value;
+    }
+    out << "\n";
+    
+    out << "cache " << snapshot.lastCpuPid << " " << snapshot.cpuLastBusy << " " << snapshot.lastRunEnd.size();
+    for (const auto& entry : snapshot.lastRunEnd) {
+        out << " " << entry.first << " " << entry.second;
+    }
+    out << "\n";
+    
+    // Process definition followed by its progress
+    out << "processes " << snapshot.processes.size() << "\n";
+    for (const auto& process : snapshot.processes) {
+        if (process->getBehavior()) {
+            std::cerr << "Error: Process " << process->getId()
+                      << " follows a burst behavior, which checkpoint files cannot hold" << std::endl;
+            return false;
+        }
+        if (process->getGroup() >= 0 || process->hasPredecessors()) {
+            std::cerr << "Error: Process " << process->getId()
+                      << " belongs to a job (group= or after=), which checkpoint files cannot hold" << std::endl;
+            return false;
+        }
+        
+        const auto& bursts = process->getBursts();
+        out << "process " << process->getId() << " " << process->getArrivalTime() << " "
+            << process->getPriority() << " " << process->getTickets() << " "
+            << static_cast<int>(process->getState()) << " " << process->getCurrentBurstIndex() << " "
+            << process->getRemainingTime() << " " << process->getFinishTime() << " "
+            << process->getWaitingTime() << " " << bursts.size();
+        for (const auto& burst : bursts) {
+            out << " " << (burst.type == BurstType::CPU ? "C" : "I") << " " << burst.duration;
+        }
+        out << "\n";
+    }
+    
+    out << "events " << snapshot.events.size() << " " << snapshot.nextSequence << "\n";
+    for (const auto& event : snapshot.events) {
+        out << "event " << static_cast<int>(event.type) << " " << event.time << " " << event.pid << " "
+            << event.tag << " " << event.sequence << "\n";
+    }
+    out << "end\n";
+    
+    return static_cast<bool>(out);
+}
+
+bool readSnapshot(std::istream& in, SimulationSnapshot& snapshot) {
+    int version = 0;
+    if (!expectKeyword(in, CHECKPOINT_MAGIC) || !(in >> version) || version != CHECKPOINT_VERSION) {
+        std::cerr << "Error: Unsupported checkpoint version" << std::endl;
+        return false;
+    }
+    
+    if (!expectKeyword(in, "algorithm") || !(in >> snapshot.algorithm)) return false;
+    
+    if (!expectKeyword(in, "clock") ||
+        !(in >> snapshot.currentTime >> snapshot.processSwitchTime >> snapshot.switchInProgress
+             >> snapshot.runStartTime >> snapshot.runningTag >> snapshot.nextTag
+             >> snapshot.processedEvents >> snapshot.dispatchDecisions)) {
+        return false;
+    }
+    
+    if (!expectKeyword(in, "switchcost") || !(in >> snapshot.switchCostSpec)) return false;
+    
+    if (!expectKeyword(in, "scheduler") ||
+        !(in >> snapshot.cpuBusyTime >> snapshot.contextSwitchCount >> snapshot.currentPid
+             >> snapshot.timeQuantum >> snapshot.currentTimeSlice)) {
+        return false;
+    }
+    
+    if (!expectKeyword(in, "ready") || !readList(in, "ready", snapshot.readyPids)) return false;
+    if (!expectKeyword(in, "policy") || !readList(in, "policy", snapshot.policyState)) return false;
+    if (!expectKeyword(in, "overhead") || !readList(in, "overhead", snapshot.switchBreakdown)) return false;
+    
+    size_t count = 0;
+    if (!expectKeyword(in, "cache") || !(in >> snapshot.lastCpuPid >> snapshot.cpuLastBusy) ||
+        !readCount(in, "cache", count)) {
+        return false;
+    }
+    snapshot.lastRunEnd.clear();
+    snapshot.lastRunEnd.reserve(std::min(count, MAX_RESERVE));
+    for (size_t i = 0; i < count; i++) {
+        std::pair<int, int> entry;
+        if (!(in >> entry.first >> entry.second)) {
+            std::cerr << "Error: Checkpoint ends inside the cache list" << std::endl;
+            return false;
+        }
+        snapshot.lastRunEnd.push_back(entry);
+    }
+    
+    if (!expectKeyword(in, "processes") || !readCount(in, "process", count)) return false;
+    for (size_t i = 0; i < count; i++) {
+        int pid, arrival, priority, tickets, state, burstIndex, remaining, finish, waiting;
+        size_t numBursts;
+        if (!expectKeyword(in, "process") ||
+            !(in >> pid >> arrival >> priority >> tickets >> state >> burstIndex >> remaining >> finish >> waiting) ||
+            !readCount(in, "burst", numBursts)) {
+            return false;
+        }
+        
+        auto process = std::make_shared<Process>(pid, arrival);
+        process->setPriority(priority);
+        process->setTickets(tickets);
+        for (size_t j = 0; j < numBursts; j++) {
+            std::string type;
+            int duration;
+            if (!(in >> type >> duration) || (type != "C" && type != "I") || duration < 0) {
+                std::cerr << "Error: Invalid burst " << j + 1 << " of process " << pid << " in checkpoint" << std::endl;
+                return false;
+            }
+            
+            if (type == "C") {
+                process->addCPUBurst(duration);
+            } else {
+                process->addIOBurst(duration);
+            }
+        }
+        
+        if (state < 0 || state > static_cast<int>(ProcessState::TERMINATED) ||
+            burstIndex < 0 || burstIndex > static_cast<int>(numBursts)) {
+            std::cerr << "Error: Invalid progress for process " << pid << " in checkpoint" << std::endl;
+            return false;
+        }
+        process->restoreProgress(burstIndex, remaining, static_cast<ProcessState>(state), finish, waiting);
+        snapshot.processes.push_back(process);
+    }
+    
+    if (!expectKeyword(in, "events") || !readCount(in, "event", count) || !(in >> snapshot.nextSequence)) return false;
+    for (size_t i = 0; i < count; i++) {
+        EventRecord record;
+        int type;
+        if (!expectKeyword(in, "event") ||
+            !(in >> type >> record.time >> record.pid >> record.tag >> record.sequence)) {
+            return false;
+        }
+        if (type < 0 || type > static_cast<int>(EventType::SWAP_IN_COMPLETE)) {
+            std::cerr << "Error: Invalid event type in checkpoint" << std::endl;
+            return false;
+        }
+        record.type = static_cast<EventType>(type);
+        snapshot.events.push_back(record);
+    }
+    
+    return expectKeyword(in, "end");
+}
+
+bool runWhatIfVariants(const SimulationParams& params, std::shared_ptr<const SimulationSnapshot> snapshot) {
+    std::vector<int> quanta = params.quantumVariants;
+    std::vector<int> switchTimes = params.switchVariants;
+    // Only fixed-quantum Round Robin runs record a quantum (RRA derives its slices)
+    bool roundRobin = snapshot->timeQuantum > 0;
+    
+    if (!quanta.empty() && !roundRobin) {
+        std::cerr << "Error: Quantum variants need a fixed-quantum Round Robin algorithm (RR10, RR50 or RR100), "
+                  << "checkpoint uses " << snapshot->algorithm << std::endl;
+        return false;
+    }
+    if (quanta.empty()) {
+        quanta.push_back(snapshot->timeQuantum);
+    }
+    if (switchTimes.empty()) {
+        switchTimes.push_back(snapshot->processSwitchTime);
+    }
+    
+    // Every fork restores from the same shared snapshot
+    struct Variant {
+        int quantum;
+        int switchTime;
+        std::unique_ptr<Simulator> simulator;
+        bool ok;
+    };
+    std::vector<Variant> variants;
+    for (int quantum : quanta) {
+        for (int switchTime : switchTimes) {
+            variants.push_back({quantum, switchTime, nullptr, false});
+        }
+    }
+    
+    SimulationParams forkParams = params;
+    forkParams.algorithm = snapshot->algorithm;
+    if (variants.size() > 1) {
+        // Parallel forks would interleave their traces
+        forkParams.verboseMode = false;
+    }
+    
+    {
+        ThreadPool pool(std::min<size_t>(params.threads > 0 ? params.threads : variants.size(), variants.size()));
+        for (auto& variant : variants) {
+            pool.submit([&variant, &forkParams, snapshot, roundRobin] {
+                variant.simulator = std::make_unique<Simulator>(snapshot->processSwitchTime);
+                variant.simulator->setParams(forkParams);
+                variant.ok = variant.simulator->restore(*snapshot);
+                if (!variant.ok) return;
+                
+                variant.simulator->setSwitchTime(variant.switchTime);
+                if (roundRobin && !variant.simulator->setTimeQuantum(variant.quantum)) {
+                    std::cerr << "Error: Cannot set quantum " << variant.quantum << " on "
+                              << snapshot->algorithm << std::endl;
+                    variant.ok = false;
+                    return;
+                }
+                variant.simulator->finish();
+            });
+        }
+        pool.wait();
+    }
+    
+    for (const auto& variant : variants) {
+        if (!variant.ok) return false;
+        
+        std::cout << "\nWhat-if from t=" << snapshot->currentTime << ": ";
+        if (roundRobin) {
+            std::cout << "quantum=" << variant.quantum << ", ";
+        }
+        std::cout << "switch time=" << variant.switchTime << "\n";
+        variant.simulator->outputResults();
+    }
+    
+    return true;
+}
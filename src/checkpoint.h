@@ -0,0 +1,73 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "process.h"
+#include "simulator.h"
+
+// Pending event, with the process referenced by ID
+struct EventRecord {
+    EventType type;
+    int time;
+    int pid;                  // 0 = no process
+    unsigned long tag;
+    unsigned long sequence;
+};
+
+// Full state of a step-wise simulator run at one point in simulated time
+struct SimulationSnapshot {
+    // Simulator
+    std::string algorithm;
+    int currentTime = 0;
+    int processSwitchTime = 0;
+    std::string switchCostSpec = "flat";
+    bool switchInProgress = false;
+    int runStartTime = 0;
+    unsigned long runningTag = 0;
+    unsigned long nextTag = 0;
+    long long processedEvents = 0;
+    long long dispatchDecisions = 0;
+    
+    // Event queue
+    std::vector<EventRecord> events;
+    unsigned long nextSequence = 0;
+    
+    // Active scheduler
+    int cpuBusyTime = 0;
+    int contextSwitchCount = 0;
+    int currentPid = 0;       // 0 = CPU idle or switching
+    std::vector<int> readyPids;
+    int timeQuantum = 0;      // Round Robin only
+    int currentTimeSlice = 0;
+    std::vector<double> policyState;   // Scheduler::getPolicyState()
+    std::vector<long long> switchBreakdown;   // Scheduler::getSwitchBreakdown()
+    
+    // Cache warmth for the switch cost model
+    int lastCpuPid = 0;
+    int cpuLastBusy = 0;
+    std::vector<std::pair<int, int>> lastRunEnd;   // (pid, time) in pid order
+    
+    // Processes with their burst progress (burst lists shared, copy-on-write)
+    std::vector<std::shared_ptr<const Process>> processes;
+    
+    // Control groups: hierarchy, accounting and held-back (group index, pid)
+    // pairs; in-memory snapshots only
+    std::shared_ptr<const CgroupHierarchy> cgroups;
+    std::vector<long long> cgroupState;
+    std::vector<std::pair<int, int>> throttledPids;
+};
+
+// Text serialization of snapshots
+bool writeSnapshot(const SimulationSnapshot& snapshot, std::ostream& out);
+bool readSnapshot(std::istream& in, SimulationSnapshot& snapshot);
+
+// Continue a snapshot under every combination of params.quantumVariants and
+// params.switchVariants (each defaults to the snapshot's own value). Forks
+// run in parallel and their results are printed in variant order.
+bool runWhatIfVariants(const SimulationParams& params, std::shared_ptr<const SimulationSnapshot> snapshot);
+
+#endif // CHECKPOINT_H
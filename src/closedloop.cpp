@@ -0,0 +1,120 @@
+#include "closedloop.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include "threadpool.h"
+
+ClosedLoopSource::ClosedLoopSource(const GeneratorSpec& spec, double meanThinkTime, int horizonTime,
+                                   unsigned long long seed)
+    : generator(spec, seed),
+      thinkDist(1.0 / std::max(meanThinkTime, 1e-9)),
+      thinkGen(WorkloadGenerator::replicationSeed(seed, 0)),
+      horizon(horizonTime),
+      completions(0),
+      totalResponse(0.0),
+      totalWaiting(0.0) {
+}
+
+std::shared_ptr<Process> ClosedLoopSource::firstJob(int client) {
+    return generator.generateJob(client, static_cast<int>(thinkDist(thinkGen)));
+}
+
+std::shared_ptr<Process> ClosedLoopSource::onCompletion(const Process& process, int time) {
+    if (process.getFinishTime() <= horizon) {
+        completions++;
+        totalResponse += process.getTurnaroundTime();
+        totalWaiting += process.getWaitingTime();
+    }
+    
+    // The client thinks, then submits its next job under the same ID
+    return generator.generateJob(process.getId(), time + static_cast<int>(thinkDist(thinkGen)));
+}
+
+ClosedLoopRunner::ClosedLoopRunner(const SimulationParams& simulationParams, const GeneratorSpec& generatorSpec)
+    : params(simulationParams), spec(generatorSpec) {
+    params.verboseMode = false;
+    params.detailedMode = false;
+}
+
+bool ClosedLoopRunner::run() {
+    std::vector<std::string> algorithms;
+    if (params.algorithm == "ALL") {
+        algorithms = Simulator::algorithmNames();
+    } else {
+        algorithms = {params.algorithm};
+    }
+    
+    struct Point {
+        std::string name;
+        long long completions;
+        double avgResponse;
+        double avgWaiting;
+        double utilization;
+    };
+    
+    const std::vector<int>& clientCounts = params.closedClients;
+    std::vector<std::vector<Point>> results(algorithms.size(), std::vector<Point>(clientCounts.size()));
+    
+    {
+        ThreadPool pool(params.threads);
+        for (size_t a = 0; a < algorithms.size(); a++) {
+            for (size_t n = 0; n < clientCounts.size(); n++) {
+                pool.submit([this, a, n, &algorithms, &clientCounts, &results] {
+                    // Same seed for every algorithm at a given client count (common random numbers)
+                    auto source = std::make_shared<ClosedLoopSource>(
+                        spec, params.thinkTime, params.closedHorizon,
+                        WorkloadGenerator::replicationSeed(params.seed, n));
+                    
+                    Simulator simulator(spec.contextSwitchTime);
+                    simulator.setOutput(nullptr);
+                    simulator.initialize({});
+                    SimulationParams jobParams = params;
+                    jobParams.algorithm = algorithms[a];
+                    simulator.setParams(jobParams);
+                    simulator.setJobSource(source);
+                    
+                    simulator.start();
+                    for (int client = 1; client <= clientCounts[n]; client++) {
+                        simulator.addArrival(source->firstJob(client), false);
+                    }
+                    simulator.runUntil(params.closedHorizon);
+                    
+                    auto scheduler = simulator.getActiveScheduler();
+                    Point& point = results[a][n];
+                    point.name = scheduler->getName();
+                    point.completions = source->getCompletions();
+                    point.avgResponse = source->getAvgResponse();
+                    point.avgWaiting = source->getAvgWaiting();
+                    point.utilization = 100.0 * scheduler->getCpuBusyTime() / params.closedHorizon;
+                });
+            }
+        }
+        pool.wait();
+    }
+    
+    // Operational bound: CPU demand D and delay Z (think time plus I/O) per
+    // job put the knee of the throughput curve at N* = (D + Z) / D
+    double meanBursts = std::max(1, spec.meanCPUBursts);
+    double demand = meanBursts * (spec.minCPUBurst + spec.maxCPUBurst) / 2.0;
+    double delay = params.thinkTime + (meanBursts - 1.0) * (spec.minIOBurst + spec.maxIOBurst) / 2.0;
+    
+    std::cout << "Closed system: mean think time " << params.thinkTime << ", horizon " << params.closedHorizon
+              << ", seed " << params.seed << "\n"
+              << "Workload spec: " << spec.toString() << "\n"
+              << "Saturation estimate N* = (D + Z) / D = " << std::fixed << std::setprecision(2)
+              << (demand + delay) / demand << " clients (D = " << demand << ", Z = " << delay << ")\n";
+    
+    for (size_t a = 0; a < algorithms.size(); a++) {
+        std::cout << "\n" << results[a][0].name << " Results:\n"
+                  << "  Clients  Completed  Throughput/1000  Avg Response  Avg Waiting  CPU Utilization\n";
+        for (size_t n = 0; n < clientCounts.size(); n++) {
+            const Point& point = results[a][n];
+            std::cout << std::setw(9) << clientCounts[n] << std::setw(11) << point.completions
+                      << std::setw(17) << 1000.0 * point.completions / params.closedHorizon
+                      << std::setw(14) << point.avgResponse << std::setw(13) << point.avgWaiting
+                      << std::setw(16) << point.utilization << "%\n";
+        }
+    }
+    
+    return true;
+}
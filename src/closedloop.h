@@ -0,0 +1,56 @@
+#ifndef CLOSEDLOOP_H
+#define CLOSEDLOOP_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "process.h"
+#include "simulator.h"
+#include "workloadgen.h"
+
+// One closed-loop client population: every client submits a job, waits for
+// it to finish, thinks for an exponentially distributed time and submits the
+// next one. Jobs are drawn from the generator spec only when submitted, and a
+// client's jobs reuse its ID, so memory stays constant however long the run.
+class ClosedLoopSource : public JobSource {
+private:
+    WorkloadGenerator generator;
+    std::exponential_distribution<> thinkDist;
+    std::mt19937_64 thinkGen;
+    int horizon;
+    
+    // Jobs finished within the horizon
+    long long completions;
+    double totalResponse;
+    double totalWaiting;
+    
+public:
+    ClosedLoopSource(const GeneratorSpec& spec, double meanThinkTime, int horizonTime,
+                     unsigned long long seed);
+    
+    // First job of a client, submitted after one think time
+    std::shared_ptr<Process> firstJob(int client);
+    
+    std::shared_ptr<Process> onCompletion(const Process& process, int time) override;
+    
+    long long getCompletions() const { return completions; }
+    double getAvgResponse() const { return completions > 0 ? totalResponse / completions : 0.0; }
+    double getAvgWaiting() const { return completions > 0 ? totalWaiting / completions : 0.0; }
+};
+
+// Closed-system runs: every selected algorithm against every client count,
+// each simulated up to the horizon on the thread pool; reports throughput
+// and response time against the number of clients (saturation curves)
+class ClosedLoopRunner {
+private:
+    SimulationParams params;
+    GeneratorSpec spec;
+    
+public:
+    ClosedLoopRunner(const SimulationParams& simulationParams, const GeneratorSpec& generatorSpec);
+    
+    bool run();
+};
+
+#endif // CLOSEDLOOP_H
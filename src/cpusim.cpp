@@ -0,0 +1,163 @@
+#include "cpusim.h"
+#include <algorithm>
+#include "simulator.h"
+
+SimulationOptions::SimulationOptions(const std::string& algorithmCode) : algorithm(algorithmCode) {
+    SimulationParams defaults;
+    switchCost = defaults.switchCostSpec;
+    dvfs = defaults.dvfsSpec;
+    seed = defaults.seed;
+    predictionAlpha = defaults.predictionAlpha;
+    initialPrediction = defaults.initialPrediction;
+    agingInterval = defaults.agingInterval;
+    targetLatency = defaults.targetLatency;
+    minGranularity = defaults.minGranularity;
+    gangSlot = defaults.gangSlot;
+    steadyStatePrecision = defaults.steadyStatePrecision;
+}
+
+const std::vector<std::string>& simulationAlgorithms() {
+    return Simulator::algorithmNames();
+}
+
+bool buildProcesses(const WorkloadSpec& workload, std::vector<std::shared_ptr<Process>>& processes,
+                    std::string& error) {
+    if (workload.processes.empty()) {
+        error = "Workload has no processes";
+        return false;
+    }
+    if (workload.contextSwitchTime < 0) {
+        error = "Context switch time must be non-negative";
+        return false;
+    }
+    
+    processes.clear();
+    processes.reserve(workload.processes.size());
+    
+    for (size_t i = 0; i < workload.processes.size(); i++) {
+        const ProcessSpec& spec = workload.processes[i];
+        std::string which = "process " + std::to_string(i + 1);
+        
+        if (spec.arrivalTime < 0) {
+            error = "Negative arrival time for " + which;
+            return false;
+        }
+        if (spec.bursts.size() % 2 == 0) {
+            error = "Bursts of " + which + " must alternate CPU and I/O and end with CPU";
+            return false;
+        }
+        if (std::any_of(spec.bursts.begin(), spec.bursts.end(), [](int duration) { return duration <= 0; })) {
+            error = "Non-positive burst time for " + which;
+            return false;
+        }
+        if (spec.priority < 0 || spec.priority >= PRIORITY_LEVELS) {
+            error = "Priority of " + which + " must be in 0.." + std::to_string(PRIORITY_LEVELS - 1);
+            return false;
+        }
+        if (spec.tickets < 1 || spec.tickets > MAX_TICKETS) {
+            error = "Tickets of " + which + " must be in 1.." + std::to_string(MAX_TICKETS);
+            return false;
+        }
+        
+        auto process = std::make_shared<Process>(static_cast<int>(i + 1), spec.arrivalTime);
+        process->setPriority(spec.priority);
+        process->setTickets(spec.tickets);
+        for (size_t b = 0; b < spec.bursts.size(); b++) {
+            if (b % 2 == 0) {
+                process->addCPUBurst(spec.bursts[b]);
+            } else {
+                process->addIOBurst(spec.bursts[b]);
+            }
+        }
+        processes.push_back(process);
+    }
+    
+    return true;
+}
+
+bool simulateWorkload(const WorkloadSpec& workload, const SimulationOptions& options,
+                      SimulationResult& result, std::string& error) {
+    std::vector<std::shared_ptr<Process>> processes;
+    if (!buildProcesses(workload, processes, error)) {
+        return false;
+    }
+    return simulateProcesses(processes, workload.contextSwitchTime, options, result, error);
+}
+
+bool simulateProcesses(const std::vector<std::shared_ptr<Process>>& processes, int contextSwitchTime,
+                       const SimulationOptions& options, SimulationResult& result, std::string& error) {
+    const auto& names = Simulator::algorithmNames();
+    if (std::find(names.begin(), names.end(), options.algorithm) == names.end()) {
+        error = "Unknown algorithm '" + options.algorithm + "' (one algorithm code is required)";
+        return false;
+    }
+    if (!SwitchCostModel::create(options.switchCost)) {
+        error = "Invalid switch cost model '" + options.switchCost + "'";
+        return false;
+    }
+    if (!options.dvfs.empty() && !DvfsModel::create(options.dvfs)) {
+        error = "Invalid DVFS spec '" + options.dvfs + "'";
+        return false;
+    }
+    if (processes.empty()) {
+        error = "Workload has no processes";
+        return false;
+    }
+    
+    // Runs mutate their processes; copies share the burst lists (copy-on-write)
+    std::vector<std::shared_ptr<Process>> copies;
+    copies.reserve(processes.size());
+    for (const auto& process : processes) {
+        copies.push_back(std::make_shared<Process>(*process));
+    }
+    
+    // Everything else keeps the command line defaults: no output files,
+    // traces, telemetry or analytics
+    SimulationParams runParams;
+    runParams.algorithm = options.algorithm;
+    runParams.switchCostSpec = options.switchCost;
+    runParams.dvfsSpec = options.dvfs;
+    runParams.seed = options.seed;
+    runParams.predictionAlpha = options.predictionAlpha;
+    runParams.initialPrediction = options.initialPrediction;
+    runParams.agingInterval = options.agingInterval;
+    runParams.targetLatency = options.targetLatency;
+    runParams.minGranularity = options.minGranularity;
+    runParams.gangSlot = options.gangSlot;
+    runParams.steadyStatePrecision = options.steadyStatePrecision;
+    
+    Simulator simulator(contextSwitchTime);
+    simulator.setOutput(nullptr);
+    simulator.initialize(copies);
+    simulator.setParams(runParams);
+    simulator.run();
+    
+    RunSummary summary = simulator.summarize();
+    result.summary.algorithm = summary.algorithm;
+    result.summary.name = summary.name;
+    result.summary.processes = summary.processes;
+    result.summary.totalTime = summary.totalTime;
+    result.summary.cpuUtilization = summary.cpuUtilization;
+    result.summary.contextSwitches = summary.contextSwitches;
+    result.summary.avgTurnaround = summary.avgTurnaround;
+    result.summary.avgWaiting = summary.avgWaiting;
+    result.switchOverhead = simulator.getActiveScheduler()->getSwitchOverhead();
+    result.processedEvents = simulator.getProcessedEvents();
+    
+    result.processes.clear();
+    result.processes.reserve(copies.size());
+    for (const auto& process : copies) {
+        ProcessResult entry;
+        entry.id = process->getId();
+        entry.arrivalTime = process->getArrivalTime();
+        entry.serviceTime = process->getServiceTime();
+        entry.ioTime = process->getIOTime();
+        entry.finishTime = process->getFinishTime();
+        entry.turnaroundTime = process->getTurnaroundTime();
+        entry.waitingTime = process->getWaitingTime();
+        entry.completed = process->getRemainingCPUTime() == 0;
+        result.processes.push_back(entry);
+    }
+    
+    return true;
+}
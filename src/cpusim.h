@@ -0,0 +1,109 @@
+#ifndef CPUSIM_H
+#define CPUSIM_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "process.h"
+
+// Embeddable simulator API (libcpusim.a): build a workload in memory, pick an
+// algorithm and its parameters in SimulationOptions, run it and read the
+// results back. Runs print nothing and write no files (invalid switch cost
+// and DVFS specs are also reported on std::cerr). Calls share no state, so
+// independent runs may go on different threads. The options are mapped onto
+// the command line's SimulationParams internally, so callers do not depend
+// on simulator.h.
+
+// One process of an in-memory workload
+struct ProcessSpec {
+    int arrivalTime;
+    std::vector<int> bursts;     // CPU, I/O, CPU, ..., CPU (odd length, all > 0)
+    int priority;
+    int tickets;
+    
+    ProcessSpec(int arrival = 0, std::vector<int> burstTimes = {},
+                int staticPriority = DEFAULT_PRIORITY, int ticketCount = DEFAULT_TICKETS)
+        : arrivalTime(arrival), bursts(std::move(burstTimes)),
+          priority(staticPriority), tickets(ticketCount) {}
+};
+
+// In-memory workload; process IDs are positions + 1
+struct WorkloadSpec {
+    int contextSwitchTime;
+    std::vector<ProcessSpec> processes;
+    
+    WorkloadSpec(int switchTime = 0) : contextSwitchTime(switchTime) {}
+    
+    void addProcess(const ProcessSpec& process) { processes.push_back(process); }
+};
+
+// Algorithm and scheduling parameters of one run; the defaults are those of
+// the command line
+struct SimulationOptions {
+    std::string algorithm;          // One code of simulationAlgorithms()
+    std::string switchCost;         // "flat" or "affinity[,key=value...]", as for -k
+    std::string dvfs;               // Governor spec as for -P (empty = fixed top frequency)
+    unsigned long long seed;        // LOTTERY draws
+    double predictionAlpha;         // PSJF / PSRTN: weight of the latest burst
+    double initialPrediction;       // PSJF / PSRTN: prediction before any burst
+    int agingInterval;              // PRIO: ready-queue wait per promotion (0 = off)
+    int targetLatency;              // RRA: every waiting process runs within this time
+    int minGranularity;             // RRA: shortest quantum handed out
+    int gangSlot;                   // GANG: CPU time per gang turn
+    double steadyStatePrecision;    // Stop at this CI half-width / mean (0 = off)
+    
+    SimulationOptions(const std::string& algorithmCode = "FCFS");
+};
+
+// Summary statistics of one run
+struct SimulationSummary {
+    std::string algorithm;
+    std::string name;
+    int processes;
+    int totalTime;
+    double cpuUtilization;
+    int contextSwitches;
+    double avgTurnaround;
+    double avgWaiting;
+};
+
+// Per-process outcome of a run
+struct ProcessResult {
+    int id;
+    int arrivalTime;
+    int serviceTime;
+    int ioTime;
+    int finishTime;
+    int turnaroundTime;
+    int waitingTime;
+    bool completed;          // False if the run stopped early (steady-state detection)
+};
+
+// Outcome of one scheduler run
+struct SimulationResult {
+    SimulationSummary summary;
+    long long switchOverhead;        // Total time spent in context switches
+    long long processedEvents;
+    std::vector<ProcessResult> processes;
+};
+
+// Build Process objects from a workload; returns false with a message in
+// 'error' if the workload is invalid
+bool buildProcesses(const WorkloadSpec& workload, std::vector<std::shared_ptr<Process>>& processes,
+                    std::string& error);
+
+// Algorithm codes accepted in SimulationOptions::algorithm (as for -a)
+const std::vector<std::string>& simulationAlgorithms();
+
+// Run options.algorithm on the workload; returns false with a message in
+// 'error' on invalid input
+bool simulateWorkload(const WorkloadSpec& workload, const SimulationOptions& options,
+                      SimulationResult& result, std::string& error);
+
+// Same for already built processes, which are copied and left untouched, so
+// one built workload can be simulated many times
+bool simulateProcesses(const std::vector<std::shared_ptr<Process>>& processes, int contextSwitchTime,
+                       const SimulationOptions& options, SimulationResult& result, std::string& error);
+
+#endif // CPUSIM_H
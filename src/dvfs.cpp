@@ -0,0 +1,210 @@
+#include "dvfs.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+DvfsModel::DvfsModel()
+    : governor(Governor::PERFORMANCE),
+      speeds({40, 60, 80, 100}),
+      staticPower(0.5),
+      dynamicPower(4.0),
+      idlePower(0.3),
+      sleepPower(0.05),
+      window(100),
+      upThreshold(80) {
+}
+
+std::shared_ptr<const DvfsModel> DvfsModel::create(const std::string& spec) {
+    std::stringstream ss(spec);
+    std::string item;
+    std::getline(ss, item, ',');
+    
+    auto model = std::make_shared<DvfsModel>();
+    auto name = std::find(std::begin(GovernorStr), std::end(GovernorStr), item);
+    if (name == std::end(GovernorStr)) {
+        std::cerr << "Error: Unknown governor '" << item << "'" << std::endl;
+        return nullptr;
+    }
+    model->governor = static_cast<Governor>(name - std::begin(GovernorStr));
+    
+    while (std::getline(ss, item, ',')) {
+        size_t eq = item.find('=');
+        if (eq == std::string::npos || eq + 1 == item.size() || !model->set(item.substr(0, eq), item.substr(eq + 1))) {
+            std::cerr << "Error: Invalid DVFS setting '" << item << "'" << std::endl;
+            return nullptr;
+        }
+    }
+    return model;
+}
+
+bool DvfsModel::set(const std::string& key, const std::string& value) {
+    if (key == "levels") {
+        // Colon-separated speeds, strictly ascending, ending at 100
+        std::vector<int> levels;
+        std::stringstream ss(value);
+        std::string level;
+        while (std::getline(ss, level, ':')) {
+            char* end = nullptr;
+            long speed = std::strtol(level.c_str(), &end, 10);
+            if (level.empty() || *end != '\0' || speed < 1 || speed > 100 ||
+                (!levels.empty() && speed <= levels.back())) {
+                return false;
+            }
+            levels.push_back(static_cast<int>(speed));
+        }
+        if (levels.empty() || levels.back() != 100) {
+            return false;
+        }
+        speeds = levels;
+        return true;
+    }
+    
+    char* end = nullptr;
+    double number = std::strtod(value.c_str(), &end);
+    if (*end != '\0' || number < 0.0) {
+        return false;
+    }
+    
+    if (key == "static") {
+        staticPower = number;
+    } else if (key == "dynamic") {
+        dynamicPower = number;
+    } else if (key == "idle") {
+        idlePower = number;
+    } else if (key == "sleep") {
+        sleepPower = number;
+    } else if (key == "window" && number >= 1.0 && number == static_cast<int>(number)) {
+        window = static_cast<int>(number);
+    } else if (key == "up" && number >= 1.0 && number <= 100.0 && number == static_cast<int>(number)) {
+        upThreshold = static_cast<int>(number);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+double DvfsModel::activePower(int level) const {
+    double scale = speeds[level] / 100.0;
+    return staticPower + dynamicPower * scale * scale * scale;
+}
+
+std::string DvfsModel::describe() const {
+    std::stringstream ss;
+    ss << GovernorStr[static_cast<int>(governor)] << ": levels=";
+    for (size_t i = 0; i < speeds.size(); i++) {
+        ss << (i == 0 ? "" : ":") << speeds[i];
+    }
+    ss << ", static=" << staticPower << ", dynamic=" << dynamicPower << ", idle=" << idlePower
+       << ", sleep=" << sleepPower;
+    if (governor == Governor::ONDEMAND) {
+        ss << ", window=" << window << ", up=" << upThreshold << "%";
+    }
+    return ss.str();
+}
+
+DvfsAccounting::DvfsAccounting(std::shared_ptr<const DvfsModel> dvfsModel, int startTime)
+    : model(dvfsModel),
+      level(0),
+      windowStart(startTime),
+      windowBusy(0),
+      energy(0.0),
+      busyAtLevel(dvfsModel ? dvfsModel->speeds.size() : 0, 0),
+      idleTime(0),
+      changes(0) {
+    
+    // Ondemand starts at the top, like the others that are not powersave
+    if (model && model->governor != Governor::POWERSAVE) {
+        level = static_cast<int>(model->speeds.size()) - 1;
+    }
+}
+
+void DvfsAccounting::closeWindow() {
+    if (model->governor == Governor::ONDEMAND) {
+        int top = static_cast<int>(model->speeds.size()) - 1;
+        int load = static_cast<int>(100LL * windowBusy / model->window);
+        int next = top;
+        if (load <= model->upThreshold) {
+            int lowest = model->speeds.front();
+            int target = lowest + load * (100 - lowest) / 100;
+            next = static_cast<int>(std::lower_bound(model->speeds.begin(), model->speeds.end(), target) -
+                                    model->speeds.begin());
+        }
+        if (next != level) {
+            level = next;
+            changes++;
+        }
+    }
+    windowStart += model->window;
+    windowBusy = 0;
+}
+
+void DvfsAccounting::advance(int from, int to, bool busy) {
+    if (!busy) {
+        // Idle draw does not depend on the level; windows that are idle
+        // throughout all end in the same decision, so one stands for them all
+        energy += model->idleDraw() * (to - from);
+        idleTime += to - from;
+        int windowEnd = windowStart + model->window;
+        if (to >= windowEnd) {
+            closeWindow();
+            if (to >= windowStart + model->window) {
+                closeWindow();
+                windowStart += (to - windowStart) / model->window * model->window;
+            }
+        }
+        return;
+    }
+    
+    // Busy time is charged at the level in force in each window
+    while (from < to) {
+        int end = std::min(to, windowStart + model->window);
+        energy += model->activePower(level) * (end - from);
+        busyAtLevel[level] += end - from;
+        windowBusy += end - from;
+        from = end;
+        if (end == windowStart + model->window) {
+            closeWindow();
+        }
+    }
+}
+
+int DvfsAccounting::nextDecision(int time) const {
+    if (model->governor != Governor::ONDEMAND) {
+        return -1;
+    }
+    return std::max(windowStart + model->window, time + 1);
+}
+
+int DvfsAccounting::workDone(int pid, int elapsed, int speed) {
+    if (speed == 100) {
+        return elapsed;
+    }
+    int& progress = carry[pid];
+    long long total = progress + static_cast<long long>(elapsed) * speed;
+    progress = static_cast<int>(total % 100);
+    return static_cast<int>(total / 100);
+}
+
+int DvfsAccounting::timeFor(int pid, int work, int speed) const {
+    if (speed == 100) {
+        return work;
+    }
+    auto it = carry.find(pid);
+    long long needed = static_cast<long long>(work) * 100 - (it != carry.end() ? it->second : 0);
+    return static_cast<int>(std::max(0LL, (needed + speed - 1) / speed));
+}
+
+void DvfsAccounting::output(std::ostream& out, int totalTime) const {
+    out << "Energy (" << model->describe() << "):\n"
+        << std::fixed << std::setprecision(2)
+        << "  Energy: " << energy << " (power x time units)\n"
+        << "  Average Power: " << (totalTime > 0 ? energy / totalTime : 0.0) << "\n"
+        << "  Energy-Delay Product: " << energy * totalTime << " (energy x total time)\n"
+        << "  Busy Time per Level:";
+    for (size_t i = 0; i < busyAtLevel.size(); i++) {
+        out << (i == 0 ? " " : ", ") << model->speeds[i] << "%=" << busyAtLevel[i];
+    }
+    out << " (idle " << idleTime << ")\n"
+        << "  Frequency Changes: " << changes << "\n\n";
+}
@@ -0,0 +1,102 @@
+#ifndef DVFS_H
+#define DVFS_H
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Frequency governors
+enum class Governor {
+    PERFORMANCE,     // Always the top frequency
+    POWERSAVE,       // Always the lowest frequency
+    RACE_TO_IDLE,    // Top frequency, and a deep sleep state whenever idle
+    ONDEMAND         // Frequency follows the utilization of the last window
+};
+
+// String representation of governors (also their -P names)
+const std::string GovernorStr[] = {
+    "performance",
+    "powersave",
+    "race-to-idle",
+    "ondemand"
+};
+
+// Frequency levels and power model of a CPU, parsed from
+// "governor[,key=value...]". Levels are speeds in percent of the top
+// frequency (levels=40:60:80:100); input bursts are lengths at the top
+// frequency, so a burst of length b takes b * 100 / speed at a lower one.
+// A busy CPU (running a process or switching) draws
+//   static + dynamic * (speed / 100)^3
+// (dynamic power goes with f * V^2, and the voltage with the frequency); an
+// idle one draws 'idle', or 'sleep' in the deep state race-to-idle enters.
+// Ondemand looks at the busy share of every 'window' time units: above 'up'
+// percent it picks the top level, otherwise the lowest level of at least
+// lowest + load * (top - lowest), as the Linux ondemand governor does.
+class DvfsModel {
+private:
+    bool set(const std::string& key, const std::string& value);
+    
+public:
+    Governor governor;
+    std::vector<int> speeds;    // Ascending, the last one is 100
+    double staticPower;
+    double dynamicPower;
+    double idlePower;
+    double sleepPower;
+    int window;
+    int upThreshold;
+    
+    DvfsModel();
+    
+    // Build a model from a -P spec; reports errors on std::cerr, nullptr on error
+    static std::shared_ptr<const DvfsModel> create(const std::string& spec);
+    
+    double activePower(int level) const;
+    double idleDraw() const { return governor == Governor::RACE_TO_IDLE ? sleepPower : idlePower; }
+    std::string describe() const;
+};
+
+// Frequency and energy of one run. The simulator reports every clock
+// advance with whether the CPU was busy; energy is integrated over it and
+// the governor takes its decision whenever a utilization window closes.
+// Burst progress at a lowered speed is kept in hundredths of a time unit per
+// process, so repeated short runs lose nothing to rounding.
+class DvfsAccounting {
+private:
+    std::shared_ptr<const DvfsModel> model;
+    int level;
+    int windowStart;
+    int windowBusy;
+    double energy;
+    std::vector<long long> busyAtLevel;    // Busy time per frequency level
+    long long idleTime;
+    int changes;
+    std::unordered_map<int, int> carry;    // Process ID -> progress toward the next time unit (1/100)
+    
+    void closeWindow();
+    
+public:
+    DvfsAccounting(std::shared_ptr<const DvfsModel> dvfsModel = nullptr, int startTime = 0);
+    
+    int getSpeed() const { return model->speeds[level]; }
+    double getEnergy() const { return energy; }
+    const DvfsModel& getModel() const { return *model; }
+    
+    // The CPU was busy (or idle) over [from, to)
+    void advance(int from, int to, bool busy);
+    
+    // When the governor may next change the frequency (-1 = never)
+    int nextDecision(int time) const;
+    
+    // Burst progress of 'elapsed' time units at 'speed', and the time a
+    // process needs for 'work' more units at 'speed'
+    int workDone(int pid, int elapsed, int speed);
+    int timeFor(int pid, int work, int speed) const;
+    
+    // Energy, average power, energy-delay product and frequency residency
+    void output(std::ostream& out, int totalTime) const;
+};
+
+#endif // DVFS_H
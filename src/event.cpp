@@ -1,4 +1,55 @@
 #include "event.h"
 
-// The implementation of Event class is mainly in the header file
-// This file is included for potential future extensions
\ No newline at end of file
+int eventTypePriority(EventType type) {
+    switch (type) {
+        case EventType::CPU_BURST_COMPLETION:
+            return 0;
+        case EventType::CGROUP_THROTTLE:
+            return 1;
+        case EventType::FREQUENCY_CHANGE:
+            return 2;
+        case EventType::SWAP_OUT_COMPLETE:
+            return 3;
+        case EventType::SWAP_IN_COMPLETE:
+            return 4;
+        case EventType::IO_COMPLETION:
+            return 5;
+        case EventType::CGROUP_UNTHROTTLE:
+            return 6;
+        case EventType::PROCESS_ARRIVAL:
+            return 7;
+        case EventType::TIMER_INTERRUPT:
+            return 8;
+        case EventType::CONTEXT_SWITCH_COMPLETE:
+            return 9;
+    }
+    return 10;
+}
+
+void EventQueue::push(Event event) {
+    event.sequence = nextSequence++;
+    events.push(event);
+}
+
+void EventQueue::clear() {
+    while (!events.empty()) {
+        events.pop();
+    }
+    nextSequence = 0;
+}
+
+std::vector<Event> EventQueue::getEvents() const {
+    auto copy = events;
+    std::vector<Event> result;
+    result.reserve(copy.size());
+    while (!copy.empty()) {
+        result.push_back(copy.top());
+        copy.pop();
+    }
+    return result;
+}
+
+void EventQueue::pushRestored(Event event, unsigned long sequence) {
+    event.sequence = sequence;
+    events.push(event);
+}
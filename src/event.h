@@ -12,7 +12,12 @@ enum class EventType {
     CPU_BURST_COMPLETION,
     IO_COMPLETION,
     TIMER_INTERRUPT,
-    CONTEXT_SWITCH_COMPLETE
+    CONTEXT_SWITCH_COMPLETE,
+    CGROUP_THROTTLE,
+    CGROUP_UNTHROTTLE,
+    FREQUENCY_CHANGE,
+    SWAP_OUT_COMPLETE,
+    SWAP_IN_COMPLETE
 };
 
 // String representation of event types
@@ -21,32 +26,88 @@ const std::string EventTypeStr[] = {
     "CPU Burst Completion",
     "IO Completion",
     "Timer Interrupt",
-    "Context Switch Complete"
+    "Context Switch Complete",
+    "Cgroup Throttle",
+    "Cgroup Unthrottle",
+    "Frequency Change",
+    "Swap Out Complete",
+    "Swap In Complete"
 };
 
+// Processing order of event types that share a timestamp (lower runs first).
+// All events with the same time are handled as one batch in this order:
+//   1. CPU burst completions   - the running process leaves the CPU first
+//   2. Cgroup throttles        - a process whose group ran out of quota leaves it
+//   3. Frequency changes       - the running process continues at the new speed
+//   4. Swap-outs complete      - memory freed for processes waiting to be admitted
+//   5. Swap-ins complete       - swapped-in processes join the ready queue
+//   6. I/O completions         - returning processes join the ready queue
+//   7. Cgroup unthrottles      - held-back processes of a refilled group return
+//   8. Process arrivals        - new processes join the ready queue
+//   9. Timer interrupts        - an expired process is queued behind everything
+//                                that became ready at the same instant
+//  10. Context switch complete - the dispatched process starts running
+// Events of the same type keep the order in which they were pushed.
+int eventTypePriority(EventType type);
+
 // Event structure
 class Event {
 private:
     EventType type;
     int time;
     std::shared_ptr<Process> process;
+    unsigned long tag;       // Dispatch tag, used to discard stale CPU events (cgroup index when unthrottling)
+    unsigned long sequence;  // Insertion order, assigned by EventQueue
+    
+    friend class EventQueue;
     
 public:
-    Event(EventType t, int timeStamp, std::shared_ptr<Process> p = nullptr)
-        : type(t), time(timeStamp), process(p) {}
+    Event(EventType t, int timeStamp, std::shared_ptr<Process> p = nullptr, unsigned long dispatchTag = 0)
+        : type(t), time(timeStamp), process(p), tag(dispatchTag), sequence(0) {}
     
     // Getters
     EventType getType() const { return type; }
     int getTime() const { return time; }
     std::shared_ptr<Process> getProcess() const { return process; }
+    unsigned long getTag() const { return tag; }
+    unsigned long getSequence() const { return sequence; }
     
-    // Compare events for priority queue (based on time)
+    // Compare events for priority queue (time, then type priority, then insertion order)
     bool operator>(const Event& other) const {
-        return time > other.time;
+        if (time != other.time) {
+            return time > other.time;
+        }
+        int priority = eventTypePriority(type);
+        int otherPriority = eventTypePriority(other.type);
+        if (priority != otherPriority) {
+            return priority > otherPriority;
+        }
+        return sequence > other.sequence;
     }
 };
 
-// Event queue - priority queue based on event time
-typedef std::priority_queue<Event, std::vector<Event>, std::greater<Event>> EventQueue;
+// Event queue - priority queue based on event time with deterministic tie-breaking
+class EventQueue {
+private:
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    unsigned long nextSequence;
+    
+public:
+    EventQueue() : nextSequence(0) {}
+    
+    void push(Event event);
+    const Event& top() const { return events.top(); }
+    void pop() { events.pop(); }
+    bool empty() const { return events.empty(); }
+    size_t size() const { return events.size(); }
+    void clear();
+    
+    // Checkpoint support: contents in processing order and re-insertion with the
+    // original insertion order so ties resolve exactly as before
+    std::vector<Event> getEvents() const;
+    void pushRestored(Event event, unsigned long sequence);
+    unsigned long getNextSequence() const { return nextSequence; }
+    void setNextSequence(unsigned long sequence) { nextSequence = sequence; }
+};
 
-#endif // EVENT_H
\ No newline at end of file
+#endif // EVENT_H
@@ -5,7 +5,7 @@ FCFSScheduler::FCFSScheduler(int contextSwitchTime)
 }
 
 void FCFSScheduler::addProcess(std::shared_ptr<Process> process) {
-    readyQueue.push(process);
+    readyQueue.push_back(process);
     process->setState(ProcessState::READY);
 }
 
@@ -15,7 +15,7 @@ std::shared_ptr<Process> FCFSScheduler::getNextProcess() {
     }
     
     auto process = readyQueue.front();
-    readyQueue.pop();
+    readyQueue.pop_front();
     return process;
 }
 
@@ -25,22 +25,12 @@ bool FCFSScheduler::shouldPreempt(std::shared_ptr<Process> newProcess) {
 }
 
 void FCFSScheduler::updateWaitingTime(int timeElapsed) {
-    // In FCFS, we update waiting time for all processes in the ready queue
-    size_t queueSize = readyQueue.size();
-    std::queue<std::shared_ptr<Process>> tempQueue;
-    
-    // Process each element in the queue
-    for (size_t i = 0; i < queueSize; i++) {
-        auto process = readyQueue.front();
-        readyQueue.pop();
-        
-        // Update waiting time
+    // Update waiting time for all processes in the ready queue (in place)
+    for (auto& process : readyQueue) {
         process->incrementWaitingTime(timeElapsed);
-        
-        // Put it back
-        tempQueue.push(process);
     }
-    
-    // Restore the queue
-    readyQueue = tempQueue;
+}
+
+std::vector<std::shared_ptr<Process>> FCFSScheduler::getReadyProcesses() const {
+    return std::vector<std::shared_ptr<Process>>(readyQueue.begin(), readyQueue.end());
 }
\ No newline at end of file
@@ -1,13 +1,13 @@
 #ifndef FCFS_H
 #define FCFS_H
 
-#include <queue>
+#include <deque>
 #include "scheduler.h"
 
 // First Come First Serve Scheduler
 class FCFSScheduler : public Scheduler {
 private:
-    std::queue<std::shared_ptr<Process>> readyQueue;
+    std::deque<std::shared_ptr<Process>> readyQueue;
     
 public:
     FCFSScheduler(int contextSwitchTime);
@@ -18,9 +18,10 @@ public:
     bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
     bool isPreemptive() const override { return false; }
     void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
     
     // FCFS specific methods
-    size_t getReadyQueueSize() const { return readyQueue.size(); }
+    size_t getReadyQueueSize() const override { return readyQueue.size(); }
 };
 
 #endif // FCFS_H
\ No newline at end of file
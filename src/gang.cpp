@@ -0,0 +1,154 @@
+#include "gang.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+GangScheduler::GangScheduler(int contextSwitchTime, int slot)
+    : Scheduler("Gang", contextSwitchTime),
+      readyCount(0),
+      gangSlot(slot),
+      currentGang(NO_GANG),
+      slotRemaining(0),
+      timeSlice(0),
+      soloSlice(false),
+      slots(0),
+      memberDispatches(0) {
+    setGangSlot(slot);
+}
+
+void GangScheduler::setGangSlot(int slot) {
+    gangSlot = slot;
+    
+    std::stringstream ss;
+    ss << "Gang (slot=" << slot << ")";
+    name = ss.str();
+}
+
+int GangScheduler::gangOf(const Process& process) {
+    // Ungrouped processes form singleton gangs keyed by their negated ID
+    return process.getGroup() >= 0 ? process.getGroup() : -process.getId();
+}
+
+void GangScheduler::addProcess(std::shared_ptr<Process> process) {
+    int key = gangOf(*process);
+    Gang& gang = gangs[key];
+    gang.members.push_back(process);
+    if (!gang.queued) {
+        gang.queued = true;
+        gangOrder.push_back(key);
+    }
+    readyCount++;
+    process->setState(ProcessState::READY);
+}
+
+std::shared_ptr<Process> GangScheduler::getNextProcess() {
+    while (!gangOrder.empty()) {
+        int key = gangOrder.front();
+        auto it = gangs.find(key);
+        
+        // Gangs leave the turn order once none of their members is ready
+        if (it->second.members.empty()) {
+            gangOrder.pop_front();
+            gangs.erase(it);
+            continue;
+        }
+        
+        // An expired slot passes the CPU to the next gang
+        if (key == currentGang && slotRemaining <= 0 && gangOrder.size() > 1) {
+            gangOrder.pop_front();
+            gangOrder.push_back(key);
+            currentGang = NO_GANG;
+            continue;
+        }
+        
+        auto process = it->second.members.front();
+        it->second.members.pop_front();
+        readyCount--;
+        return process;
+    }
+    return nullptr;
+}
+
+bool GangScheduler::shouldPreempt(std::shared_ptr<Process> newProcess) {
+    // Other gangs wait for their turn; a gang mate shares the rest of the slot
+    return soloSlice && gangOf(*newProcess) == currentGang;
+}
+
+void GangScheduler::updateWaitingTime(int timeElapsed) {
+    // Update waiting time for all ready members (in place)
+    for (auto& entry : gangs) {
+        for (auto& process : entry.second.members) {
+            process->incrementWaitingTime(timeElapsed);
+        }
+    }
+}
+
+std::vector<std::shared_ptr<Process>> GangScheduler::getReadyProcesses() const {
+    // Gang turn order, then member order; re-adding them rebuilds both
+    std::vector<std::shared_ptr<Process>> ready;
+    for (int key : gangOrder) {
+        const auto& members = gangs.at(key).members;
+        ready.insert(ready.end(), members.begin(), members.end());
+    }
+    return ready;
+}
+
+void GangScheduler::onDispatch(std::shared_ptr<Process> process, int) {
+    // A new gang (or a renewal for a gang running alone) starts a fresh slot
+    int key = gangOf(*process);
+    if (key != currentGang || slotRemaining <= 0) {
+        currentGang = key;
+        slotRemaining = gangSlot;
+        slots++;
+    }
+    
+    auto gang = gangs.find(key);
+    soloSlice = gang == gangs.end() || gang->second.members.empty();
+    timeSlice = soloSlice ? slotRemaining : std::min(MEMBER_QUANTUM, slotRemaining);
+    memberDispatches++;
+}
+
+void GangScheduler::onCPUTime(std::shared_ptr<Process> process, int time) {
+    if (gangOf(*process) == currentGang) {
+        slotRemaining -= time;
+    }
+}
+
+void GangScheduler::outputAlgorithmResults(std::ostream& out) const {
+    out << "Gang Slots (slot=" << gangSlot << ", member slice=" << MEMBER_QUANTUM << "): " << slots;
+    if (slots > 0) {
+        out << ", " << std::fixed << std::setprecision(2)
+            << static_cast<double>(memberDispatches) / slots << " member dispatches per slot";
+    }
+    out << "\n";
+}
+
+void GangScheduler::resetPolicyState() {
+    currentGang = NO_GANG;
+    slotRemaining = 0;
+    timeSlice = 0;
+    soloSlice = false;
+    slots = 0;
+    memberDispatches = 0;
+}
+
+std::vector<double> GangScheduler::getPolicyState() const {
+    return {static_cast<double>(gangSlot), static_cast<double>(currentGang), static_cast<double>(slotRemaining),
+            static_cast<double>(timeSlice), soloSlice ? 1.0 : 0.0, static_cast<double>(slots),
+            static_cast<double>(memberDispatches)};
+}
+
+bool GangScheduler::setPolicyState(const std::vector<double>& state) {
+    if (state.size() != 7) {
+        return false;
+    }
+    
+    setGangSlot(static_cast<int>(state[0]));
+    currentGang = static_cast<int>(state[1]);
+    slotRemaining = static_cast<int>(state[2]);
+    timeSlice = static_cast<int>(state[3]);
+    soloSlice = state[4] != 0.0;
+    slots = static_cast<long long>(state[5]);
+    memberDispatches = static_cast<long long>(state[6]);
+    return true;
+}
@@ -0,0 +1,70 @@
+#ifndef GANG_H
+#define GANG_H
+
+#include <climits>
+#include <deque>
+#include <unordered_map>
+#include "scheduler.h"
+
+// Gang scheduling of process groups
+// The ready members of one group (a gang) own the CPU for a whole gang slot,
+// taking turns in member slices, so the parallel stages of a job advance
+// together instead of being interleaved with every other job. Gangs take
+// turns round robin; a process without a group is a gang of its own. A
+// member that is the only ready one of its gang gets the rest of the slot in
+// one slice, handing over when a gang mate becomes ready. The slot is renewed
+// while its gang is the only one ready.
+class GangScheduler : public Scheduler {
+private:
+    static constexpr int MEMBER_QUANTUM = 10;   // Longest slice of one member
+    static constexpr int NO_GANG = INT_MIN;
+    
+    struct Gang {
+        std::deque<std::shared_ptr<Process>> members;   // Ready members in turn order
+        bool queued = false;                            // In gangOrder
+    };
+    
+    std::unordered_map<int, Gang> gangs;
+    std::deque<int> gangOrder;       // Gangs with ready members, in turn order
+    size_t readyCount;
+    int gangSlot;
+    
+    // Current slot
+    int currentGang;
+    int slotRemaining;
+    int timeSlice;
+    bool soloSlice;                  // The running member holds the rest of the slot
+    
+    // Statistics
+    long long slots;
+    long long memberDispatches;
+    
+    static int gangOf(const Process& process);
+    
+public:
+    GangScheduler(int contextSwitchTime, int slot);
+    
+    // Implementation of abstract methods
+    void addProcess(std::shared_ptr<Process> process) override;
+    std::shared_ptr<Process> getNextProcess() override;
+    bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
+    bool isPreemptive() const override { return true; }
+    void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    size_t getReadyQueueSize() const override { return readyCount; }
+    int getTimeSlice() const override { return timeSlice; }
+    
+    // Slot accounting and reporting
+    void onDispatch(std::shared_ptr<Process> process, int time) override;
+    void onCPUTime(std::shared_ptr<Process> process, int time) override;
+    void outputAlgorithmResults(std::ostream& out) const override;
+    void resetPolicyState() override;
+    std::vector<double> getPolicyState() const override;
+    bool setPolicyState(const std::vector<double>& state) override;
+    
+    // Gang specific methods
+    void setGangSlot(int slot);
+    int getGangSlot() const { return gangSlot; }
+};
+
+#endif // GANG_H
@@ -0,0 +1,187 @@
+#include "hostmemory.h"
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+
+MemoryAccounting::MemoryAccounting(const MemoryConfig& memoryConfig)
+    : config(memoryConfig),
+      resident(0),
+      swappingOut(0),
+      peakResident(0),
+      deviceFree(0),
+      admitted(0),
+      delayed(0),
+      totalAdmissionDelay(0),
+      maxAdmissionDelay(0),
+      swapOuts(0),
+      swapIns(0),
+      transferTime(0),
+      totalSwapDelay(0),
+      maxSwapDelay(0) {
+}
+
+int MemoryAccounting::transfer(int time, int size) {
+    int start = std::max(time, deviceFree);
+    int duration = config.swapTime(size);
+    deviceFree = start + duration;
+    transferTime += duration;
+    return deviceFree;
+}
+
+bool MemoryAccounting::arrive(std::shared_ptr<Process> process, int time) {
+    if (process->getMemorySize() == 0) return true;
+    
+    // Nobody overtakes the queue
+    if (admissionQueue.empty() && swapInQueue.empty() &&
+        resident + process->getMemorySize() <= config.capacity) {
+        resident += process->getMemorySize();
+        peakResident = std::max(peakResident, resident);
+        residency[process->getId()] = Residency::RESIDENT;
+        admitted++;
+        return true;
+    }
+    
+    admissionQueue.push_back({process, time});
+    return false;
+}
+
+void MemoryAccounting::blockedOnIO(std::shared_ptr<Process> process, int ioEnd) {
+    auto it = residency.find(process->getId());
+    if (it != residency.end() && it->second == Residency::RESIDENT) {
+        blocked[process->getId()] = {process, ioEnd};
+    }
+}
+
+bool MemoryAccounting::ioCompleted(std::shared_ptr<Process> process, int time) {
+    int pid = process->getId();
+    blocked.erase(pid);
+    auto it = residency.find(pid);
+    if (it == residency.end() || it->second == Residency::RESIDENT) return true;
+    
+    // Swapped out: back in line for memory; still on its way out: once it is out
+    if (it->second == Residency::SWAPPED) {
+        swapInQueue.push_back({process, time});
+    } else {
+        swapWaitStart[pid] = time;
+    }
+    return false;
+}
+
+void MemoryAccounting::swapOutDone(std::shared_ptr<Process> process) {
+    int pid = process->getId();
+    resident -= process->getMemorySize();
+    swappingOut -= process->getMemorySize();
+    residency[pid] = Residency::SWAPPED;
+    
+    auto waiting = swapWaitStart.find(pid);
+    if (waiting != swapWaitStart.end()) {
+        swapInQueue.push_back({process, waiting->second});
+        swapWaitStart.erase(waiting);
+    }
+}
+
+void MemoryAccounting::swapInDone(std::shared_ptr<Process> process, int time) {
+    int pid = process->getId();
+    residency[pid] = Residency::RESIDENT;
+    
+    auto waiting = swapWaitStart.find(pid);
+    if (waiting != swapWaitStart.end()) {
+        int delay = time - waiting->second;
+        totalSwapDelay += delay;
+        maxSwapDelay = std::max(maxSwapDelay, delay);
+        swapWaitStart.erase(waiting);
+    }
+}
+
+void MemoryAccounting::release(const Process& process) {
+    auto it = residency.find(process.getId());
+    if (it == residency.end()) return;
+    resident -= process.getMemorySize();
+    residency.erase(it);
+}
+
+std::vector<MemoryAction> MemoryAccounting::rebalance(int time) {
+    std::vector<MemoryAction> actions;
+    
+    // Swapped processes first, then new arrivals, each in order
+    while (hasWaiting()) {
+        bool swapped = !swapInQueue.empty();
+        std::deque<Waiting>& queue = swapped ? swapInQueue : admissionQueue;
+        Waiting head = queue.front();
+        int size = head.process->getMemorySize();
+        if (resident + size > config.capacity) {
+            makeRoom(size, time, actions);
+            break;
+        }
+        
+        queue.pop_front();
+        resident += size;
+        peakResident = std::max(peakResident, resident);
+        int pid = head.process->getId();
+        if (swapped) {
+            residency[pid] = Residency::SWAPPING_IN;
+            swapWaitStart[pid] = head.since;
+            swapIns++;
+            actions.push_back({MemoryAction::Kind::SWAP_IN, head.process, transfer(time, size)});
+        } else {
+            residency[pid] = Residency::RESIDENT;
+            int delay = time - head.since;
+            admitted++;
+            delayed += delay > 0;
+            totalAdmissionDelay += delay;
+            maxAdmissionDelay = std::max(maxAdmissionDelay, delay);
+            actions.push_back({MemoryAction::Kind::ADMIT, head.process, time});
+        }
+    }
+    
+    return actions;
+}
+
+void MemoryAccounting::makeRoom(int size, int time, std::vector<MemoryAction>& actions) {
+    // Memory on its way out already counts as free
+    long long shortfall = resident - swappingOut + size - config.capacity;
+    if (shortfall <= 0) return;
+    
+    // Victims whose I/O outlasts their swap-out, the longest-blocked first
+    std::vector<std::pair<int, int>> candidates;    // (I/O end, process ID)
+    long long available = 0;
+    int start = std::max(time, deviceFree);
+    for (const auto& entry : blocked) {
+        int victimSize = entry.second.process->getMemorySize();
+        if (entry.second.ioEnd > start + config.swapTime(victimSize)) {
+            candidates.push_back({entry.second.ioEnd, entry.first});
+            available += victimSize;
+        }
+    }
+    
+    // Swapping out is only worth it if it lets the head in
+    if (available < shortfall) return;
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    
+    for (const auto& candidate : candidates) {
+        if (shortfall <= 0) break;
+        auto victim = blocked[candidate.second].process;
+        blocked.erase(candidate.second);
+        int victimSize = victim->getMemorySize();
+        residency[candidate.second] = Residency::SWAPPING_OUT;
+        swappingOut += victimSize;
+        shortfall -= victimSize;
+        swapOuts++;
+        actions.push_back({MemoryAction::Kind::SWAP_OUT, victim, transfer(time, victimSize)});
+    }
+}
+
+void MemoryAccounting::output(std::ostream& out) const {
+    out << "Memory (capacity " << config.capacity << ", swap rate " << config.swapRate << " per time unit):\n"
+        << std::fixed << std::setprecision(2)
+        << "  Peak Resident: " << peakResident << " (" << 100.0 * peakResident / config.capacity << "%)\n"
+        << "  Admission Delay: mean " << (admitted > 0 ? static_cast<double>(totalAdmissionDelay) / admitted : 0.0)
+        << ", max " << maxAdmissionDelay << " (" << delayed << " of " << admitted << " processes delayed)\n"
+        << "  Swapping: " << swapOuts << " swap-outs, " << swapIns << " swap-ins, " << transferTime
+        << " time units of transfers\n"
+        << "  Swap Delay: total " << totalSwapDelay << ", mean "
+        << (swapIns > 0 ? static_cast<double>(totalSwapDelay) / swapIns : 0.0) << ", max " << maxSwapDelay
+        << " (I/O completion to ready)\n\n";
+}
@@ -0,0 +1,120 @@
+#ifndef HOSTMEMORY_H
+#define HOSTMEMORY_H
+
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "process.h"
+
+// Largest host memory (and process footprint) in memory units
+const int MAX_MEMORY = 1000000000;
+
+// Default swap device bandwidth in memory units per time unit
+const int DEFAULT_SWAP_RATE = 10;
+
+// Host memory declared on the input header: memory=C memory units and a swap
+// device moving swap_rate=R units per time unit. Processes declare their
+// footprint with memory=M (default 0, which never waits for memory).
+struct MemoryConfig {
+    int capacity;        // 0 = no memory model
+    int swapRate;
+    
+    MemoryConfig() : capacity(0), swapRate(DEFAULT_SWAP_RATE) {}
+    
+    bool isDefined() const { return capacity > 0; }
+    
+    // Time to move a footprint to or from the swap device
+    int swapTime(int size) const { return (size + swapRate - 1) / swapRate; }
+};
+
+// What the simulator has to do after the memory state changed
+struct MemoryAction {
+    enum class Kind {
+        ADMIT,       // The process is resident and ready now
+        SWAP_IN,     // The process becomes ready when its swap-in ends at 'time'
+        SWAP_OUT     // The process's memory is free when its swap-out ends at 'time'
+    };
+    
+    Kind kind;
+    std::shared_ptr<Process> process;
+    int time;
+};
+
+// Memory admission and swapping of one run (a medium-term scheduler). A
+// process with a footprint has to be resident to be ready: an arrival that
+// does not fit waits in the admission queue, first come first served. When
+// the head of the queue does not fit, processes blocked on I/O are swapped
+// out to make room, the one whose I/O ends last first, skipping those whose
+// I/O ends before their swap-out would. A swapped-out process whose I/O
+// completes waits for memory ahead of new arrivals, and is ready once it is
+// swapped back in. Transfers go through one swap device, one after another.
+class MemoryAccounting {
+private:
+    enum class Residency { RESIDENT, SWAPPING_OUT, SWAPPED, SWAPPING_IN };
+    
+    struct Waiting {
+        std::shared_ptr<Process> process;
+        int since;
+    };
+    
+    struct Blocked {
+        std::shared_ptr<Process> process;
+        int ioEnd;
+    };
+    
+    MemoryConfig config;
+    long long resident;              // Reserved memory, including transfers in flight
+    long long swappingOut;           // Part of it on its way out
+    long long peakResident;
+    int deviceFree;                  // When the swap device finishes its queued transfers
+    std::unordered_map<int, Residency> residency;      // Process ID -> state (absent = holds no memory)
+    std::unordered_map<int, Blocked> blocked;          // Resident processes blocked on I/O
+    std::unordered_map<int, int> swapWaitStart;        // Swapped processes whose I/O completed -> when
+    std::deque<Waiting> admissionQueue;
+    std::deque<Waiting> swapInQueue;
+    
+    // Statistics
+    long long admitted;
+    long long delayed;
+    long long totalAdmissionDelay;
+    int maxAdmissionDelay;
+    long long swapOuts;
+    long long swapIns;
+    long long transferTime;
+    long long totalSwapDelay;
+    int maxSwapDelay;
+    
+    int transfer(int time, int size);
+    void makeRoom(int size, int time, std::vector<MemoryAction>& actions);
+    
+public:
+    MemoryAccounting(const MemoryConfig& memoryConfig = MemoryConfig());
+    
+    // An arriving process: true if it is resident (or needs no memory),
+    // false if it waits in the admission queue
+    bool arrive(std::shared_ptr<Process> process, int time);
+    
+    // A resident process started an I/O burst ending at 'ioEnd'
+    void blockedOnIO(std::shared_ptr<Process> process, int ioEnd);
+    
+    // I/O completion: true if the process is resident and may be ready,
+    // false if it has to be swapped in first
+    bool ioCompleted(std::shared_ptr<Process> process, int time);
+    
+    // Transfers that ended, and a terminated process releasing its memory
+    void swapOutDone(std::shared_ptr<Process> process);
+    void swapInDone(std::shared_ptr<Process> process, int time);
+    void release(const Process& process);
+    
+    // Admit waiting processes that fit, and start swap-outs if the head of
+    // the queues does not; called after every change above
+    std::vector<MemoryAction> rebalance(int time);
+    
+    bool hasWaiting() const { return !admissionQueue.empty() || !swapInQueue.empty(); }
+    
+    void output(std::ostream& out) const;
+};
+
+#endif // HOSTMEMORY_H
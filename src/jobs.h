@@ -0,0 +1,32 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "process.h"
+
+// Process groups as jobs: fork/join DAGs whose stages are released when
+// their predecessors terminate. A job's critical path is the earliest it
+// could finish with a CPU to itself and no switch overhead (each process's
+// own CPU and I/O time along the longest dependency chain); its slack is how
+// much longer the scheduler actually made it take.
+struct JobStats {
+    int group;
+    int processes;
+    int start;           // Earliest arrival of a member
+    int finish;          // Latest termination of a member
+    int makespan;
+    int criticalPath;
+    int slack;
+};
+
+// Every dependency must name another process, and the graph must be acyclic
+bool validateDependencies(const std::vector<std::shared_ptr<Process>>& processes);
+
+// Per-job statistics of a finished run, in group order (empty without groups)
+std::vector<JobStats> computeJobStats(const std::vector<std::shared_ptr<Process>>& processes);
+
+void outputJobStats(std::ostream& out, const std::vector<JobStats>& jobs);
+
+#endif // JOBS_H
@@ -0,0 +1,135 @@
+#include "lottery.h"
+#include <sstream>
+
+LotteryScheduler::LotteryScheduler(int contextSwitchTime, int quantum)
+    : Scheduler("Lottery", contextSwitchTime),
+      tree(2, 0),
+      capacity(1),
+      totalTickets(0),
+      timeQuantum(quantum),
+      seed(1),
+      rngState(1),
+      draws(0) {
+    
+    // Append time quantum to the name
+    std::stringstream ss;
+    ss << "Lottery (quantum=" << quantum << ")";
+    name = ss.str();
+}
+
+void LotteryScheduler::addTickets(size_t slot, long long delta) {
+    for (size_t i = slot + 1; i <= capacity; i += i & (~i + 1)) {
+        tree[i] += delta;
+    }
+}
+
+size_t LotteryScheduler::findSlot(long long ticket) const {
+    // Descend the tree: largest prefix of slots whose tickets sum <= ticket
+    size_t position = 0;
+    for (size_t step = capacity; step > 0; step >>= 1) {
+        if (position + step <= capacity && tree[position + step] <= ticket) {
+            position += step;
+            ticket -= tree[position];
+        }
+    }
+    return position;
+}
+
+void LotteryScheduler::grow() {
+    capacity *= 2;
+    tree.assign(capacity + 1, 0);
+    for (size_t slot = 0; slot < slots.size(); slot++) {
+        addTickets(slot, slots[slot]->getTickets());
+    }
+}
+
+unsigned long long LotteryScheduler::nextRandom() {
+    // splitmix64: a 64-bit state is easy to checkpoint and identical on every platform
+    unsigned long long z = (rngState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void LotteryScheduler::addProcess(std::shared_ptr<Process> process) {
+    if (slots.size() == capacity) {
+        grow();
+    }
+    
+    addTickets(slots.size(), process->getTickets());
+    slots.push_back(process);
+    totalTickets += process->getTickets();
+    process->setState(ProcessState::READY);
+}
+
+std::shared_ptr<Process> LotteryScheduler::getNextProcess() {
+    if (slots.empty()) {
+        return nullptr;
+    }
+    
+    // Draw a ticket and find its holder
+    long long ticket = static_cast<long long>(nextRandom() % static_cast<unsigned long long>(totalTickets));
+    size_t winner = findSlot(ticket);
+    draws++;
+    
+    // Move the last slot into the winner's place to keep the array compact
+    std::shared_ptr<Process> process = slots[winner];
+    size_t last = slots.size() - 1;
+    long long winnerTickets = process->getTickets();
+    long long lastTickets = slots[last]->getTickets();
+    addTickets(winner, lastTickets - winnerTickets);
+    addTickets(last, -lastTickets);
+    slots[winner] = slots[last];
+    slots.pop_back();
+    totalTickets -= winnerTickets;
+    
+    return process;
+}
+
+bool LotteryScheduler::shouldPreempt(std::shared_ptr<Process>) {
+    // Lottery preempts when the time slice expires, not on arrivals
+    return false;
+}
+
+void LotteryScheduler::updateWaitingTime(int timeElapsed) {
+    // Update waiting time for all processes in the ready queue
+    for (auto& process : slots) {
+        process->incrementWaitingTime(timeElapsed);
+    }
+}
+
+std::vector<std::shared_ptr<Process>> LotteryScheduler::getReadyProcesses() const {
+    // Slot order: adding them back in this order rebuilds the same tree
+    return slots;
+}
+
+void LotteryScheduler::outputAlgorithmResults(std::ostream& out) const {
+    out << "Lottery Draws: " << draws << " (seed " << seed << ")\n";
+}
+
+void LotteryScheduler::resetPolicyState() {
+    slots.clear();
+    capacity = 1;
+    tree.assign(capacity + 1, 0);
+    totalTickets = 0;
+    rngState = seed;
+    draws = 0;
+}
+
+std::vector<double> LotteryScheduler::getPolicyState() const {
+    // 64-bit values are split into 32-bit halves to survive the conversion
+    return {static_cast<double>(seed >> 32), static_cast<double>(seed & 0xFFFFFFFFULL),
+            static_cast<double>(rngState >> 32), static_cast<double>(rngState & 0xFFFFFFFFULL),
+            static_cast<double>(draws)};
+}
+
+bool LotteryScheduler::setPolicyState(const std::vector<double>& state) {
+    if (state.size() != 5) {
+        return false;
+    }
+    
+    seed = (static_cast<unsigned long long>(state[0]) << 32) | static_cast<unsigned long long>(state[1]);
+    rngState = (static_cast<unsigned long long>(state[2]) << 32) | static_cast<unsigned long long>(state[3]);
+    draws = static_cast<long long>(state[4]);
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef LOTTERY_H
+#define LOTTERY_H
+
+#include <vector>
+#include "scheduler.h"
+
+// Lottery Scheduler (proportional share, time-sliced)
+// Every quantum a ticket is drawn at random among the tickets of all ready
+// processes and its holder runs. Ready processes sit in a compact slot array
+// indexed by a Fenwick tree of ticket counts, so drawing a winner and
+// adding or removing a process are O(log n).
+class LotteryScheduler : public Scheduler {
+private:
+    std::vector<std::shared_ptr<Process>> slots;
+    std::vector<long long> tree;   // Fenwick tree over slots, 1-based
+    size_t capacity;               // Power of two, slots.size() <= capacity
+    long long totalTickets;
+    int timeQuantum;
+    unsigned long long seed;
+    unsigned long long rngState;
+    long long draws;
+    
+    void addTickets(size_t slot, long long delta);
+    size_t findSlot(long long ticket) const;
+    void grow();
+    unsigned long long nextRandom();
+    
+public:
+    LotteryScheduler(int contextSwitchTime, int quantum);
+    
+    // Implementation of abstract methods
+    void addProcess(std::shared_ptr<Process> process) override;
+    std::shared_ptr<Process> getNextProcess() override;
+    bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
+    bool isPreemptive() const override { return true; }
+    void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    size_t getReadyQueueSize() const override { return slots.size(); }
+    int getTimeSlice() const override { return timeQuantum; }
+    
+    // Random stream state
+    void outputAlgorithmResults(std::ostream& out) const override;
+    void resetPolicyState() override;
+    std::vector<double> getPolicyState() const override;
+    bool setPolicyState(const std::vector<double>& state) override;
+    
+    // Lottery specific methods
+    void setSeed(unsigned long long value) { seed = value; rngState = value; }
+    long long getTotalTickets() const { return totalTickets; }
+};
+
+#endif // LOTTERY_H
@@ -5,24 +5,181 @@
 #include "process.h"
 #include "simulator.h"
 #include "parser.h"
+#include "batch.h"
+#include "checkpoint.h"
+#include "closedloop.h"
+#include "montecarlo.h"
+#include "multicore.h"
+#include "resultcache.h"
+#include "traceimport.h"
+#include "tuner.h"
+#include "workloadgen.h"
+#include <fstream>
+#include <sstream>
 
 int main(int argc, char* argv[]) {
     // Parse command line arguments
-    bool detailedMode = false;
-    bool verboseMode = false;
-    std::string algorithm = "ALL";
+    SimulationParams params;
     
-    if (!Parser::parseCommandLine(argc, argv, detailedMode, verboseMode, algorithm)) {
+    if (!Parser::parseCommandLine(argc, argv, params)) {
         return 1;
     }
     
+    // Batch mode: many workload files, results go to one consolidated file
+    if (!params.batchInput.empty()) {
+        BatchRunner runner(params);
+        return runner.run() ? 0 : 1;
+    }
+    
+    // Monte Carlo mode: generated workloads, no input file
+    if (params.replications > 0) {
+        GeneratorSpec spec;
+        if (!params.generatorSpec.empty() && !spec.parse(params.generatorSpec)) {
+            return 1;
+        }
+        MonteCarloRunner runner(params, spec);
+        return runner.run() ? 0 : 1;
+    }
+    
+    // Closed-system mode: client populations generate their jobs, no input file
+    if (!params.closedClients.empty()) {
+        GeneratorSpec spec;
+        if (!params.generatorSpec.empty() && !spec.parse(params.generatorSpec)) {
+            return 1;
+        }
+        ClosedLoopRunner runner(params, spec);
+        return runner.run() ? 0 : 1;
+    }
+    
+    // Resume a saved checkpoint, possibly under several parameter variants
+    if (!params.restoreFile.empty()) {
+        std::ifstream checkpointInput(params.restoreFile);
+        auto snapshot = std::make_shared<SimulationSnapshot>();
+        if (!checkpointInput || !readSnapshot(checkpointInput, *snapshot)) {
+            std::cerr << "Error: Cannot read checkpoint " << params.restoreFile << std::endl;
+            return 1;
+        }
+        return runWhatIfVariants(params, snapshot) ? 0 : 1;
+    }
+    
     // Parse input file
     std::vector<std::shared_ptr<Process>> processes;
     int contextSwitchTime;
+    Topology topology;
+    auto cgroups = std::make_shared<CgroupHierarchy>();
+    MemoryConfig memory;
     
-    Parser parser(std::cin);
-    if (!parser.parse(processes, contextSwitchTime)) {
-        return 1;
+    if (!params.traceFile.empty()) {
+        // Replay a Linux scheduler trace instead of a workload file
+        std::ifstream traceInput(params.traceFile);
+        if (!traceInput) {
+            std::cerr << "Error: Cannot open trace " << params.traceFile << std::endl;
+            return 1;
+        }
+        
+        TraceImportOptions options;
+        options.microsPerUnit = params.traceMicrosPerUnit;
+        TraceImporter importer(traceInput, options);
+        if (!importer.import(processes, contextSwitchTime)) {
+            return 1;
+        }
+        
+        if (!params.exportFile.empty()) {
+            std::ofstream exportOutput(params.exportFile);
+            WorkloadGenerator::write(exportOutput, processes, contextSwitchTime);
+        }
+    } else {
+        Parser parser(std::cin);
+        if (!parser.parse(processes, contextSwitchTime, topology, *cgroups, memory)) {
+            return 1;
+        }
+    }
+    
+    // A declared topology fixes the number of cores
+    if (topology.isDefined()) {
+        if (params.cores > 0 && params.cores != topology.getCoreCount()) {
+            std::cerr << "Error: -N " << params.cores << " does not match the input topology of "
+                      << topology.getCoreCount() << " cores" << std::endl;
+            return 1;
+        }
+        if (params.cores == 0 && (params.verboseMode || params.checkpointTime >= 0 || params.forkTime >= 0 ||
+                                  params.telemetryWindow > 0 || params.steadyStatePrecision > 0.0)) {
+            std::cerr << "Error: Inputs with a topology run the multi-core model, which does not support "
+                      << "-v, -c, -F, -w or -e" << std::endl;
+            return 1;
+        }
+        params.cores = topology.getCoreCount();
+    }
+    
+    // Quantum tuning: many Round Robin runs of the parsed workload
+    if (!params.tuningSpec.empty()) {
+        if (params.cores > 0) {
+            std::cerr << "Error: The quantum tuner does not support the multi-core model" << std::endl;
+            return 1;
+        }
+        TuningSpec spec;
+        spec.parse(params.tuningSpec);
+        QuantumTuner tuner(params, spec, processes, contextSwitchTime, cgroups, memory);
+        return tuner.run() ? 0 : 1;
+    }
+    
+    // Multi-core model: the workload is spread over simulated cores
+    if (params.cores > 0) {
+        if (!cgroups->empty()) {
+            std::cerr << "Error: The multi-core model does not support cgroups" << std::endl;
+            return 1;
+        }
+        if (memory.isDefined()) {
+            std::cerr << "Error: The multi-core model does not support the host memory model" << std::endl;
+            return 1;
+        }
+        if (!params.cacheDirectory.empty()) {
+            std::cerr << "Error: The multi-core model does not support the result cache (-R)" << std::endl;
+            return 1;
+        }
+        
+        // Cores run independently, so nothing could release a dependent process on another core
+        for (const auto& process : processes) {
+            if (process->hasPredecessors()) {
+                std::cerr << "Error: The multi-core model does not support process dependencies (after=)" << std::endl;
+                return 1;
+            }
+        }
+        
+        MultiCoreRunner runner(params, processes, contextSwitchTime, topology);
+        return runner.run() ? 0 : 1;
+    }
+    
+    // Reports cached for the same workload and parameters need no simulation;
+    // every algorithm's report is an entry of its own, so -a ALL and single
+    // algorithms share them
+    ResultCache cache(params.cacheDirectory);
+    std::vector<std::string> cachedAlgorithms;
+    std::vector<std::string> cacheKeys;
+    if (!params.cacheDirectory.empty()) {
+        if (params.algorithm == "ALL") {
+            cachedAlgorithms = Simulator::algorithmNames();
+        } else {
+            cachedAlgorithms.push_back(params.algorithm);
+        }
+        
+        std::string reports;
+        bool complete = true;
+        for (const auto& algorithm : cachedAlgorithms) {
+            SimulationParams runParams = params;
+            runParams.algorithm = algorithm;
+            cacheKeys.push_back(ResultCache::makeKey(processes, contextSwitchTime, *cgroups, memory, runParams));
+            std::string report;
+            if (complete && cache.lookup(cacheKeys.back(), report)) {
+                reports += report;
+            } else {
+                complete = false;
+            }
+        }
+        if (complete) {
+            std::cout << reports;
+            return 0;
+        }
     }
     
     // Create simulator with context switch time
@@ -32,13 +189,50 @@ int main(int argc, char* argv[]) {
     simulator.initialize(processes);
     
     // Set simulation parameters
-    SimulationParams params;
-    params.detailedMode = detailedMode;
-    params.verboseMode = verboseMode;
-    params.algorithm = algorithm;
     simulator.setParams(params);
+    if (!cgroups->empty()) {
+        simulator.setCgroups(cgroups);
+    }
+    simulator.setMemory(memory);
+    
+    // Checkpoint and/or fork what-if variants part-way through the run
+    if (params.checkpointTime >= 0 || params.forkTime >= 0) {
+        if (memory.isDefined()) {
+            std::cerr << "Error: Checkpoints cannot hold the host memory model (-c, -F)" << std::endl;
+            return 1;
+        }
+        simulator.start();
+        
+        if (params.checkpointTime >= 0) {
+            simulator.runUntil(params.checkpointTime);
+            std::ofstream checkpointOutput(params.checkpointFile);
+            if (!checkpointOutput || !writeSnapshot(*simulator.checkpoint(), checkpointOutput)) {
+                std::cerr << "Error: Cannot write checkpoint " << params.checkpointFile << std::endl;
+                return 1;
+            }
+        }
+        
+        if (params.forkTime >= 0) {
+            simulator.runUntil(params.forkTime);
+            return runWhatIfVariants(params, simulator.checkpoint()) ? 0 : 1;
+        }
+        
+        simulator.finish();
+        simulator.outputResults();
+        return 0;
+    }
     
-    if (algorithm == "ALL") {
+    if (!cacheKeys.empty()) {
+        // Each algorithm's report is collected, printed and stored
+        simulator.run();
+        for (size_t i = 0; i < cacheKeys.size(); i++) {
+            std::ostringstream report;
+            simulator.setOutput(&report);
+            simulator.outputResults(cachedAlgorithms[i]);
+            std::cout << report.str();
+            cache.store(cacheKeys[i], report.str());
+        }
+    } else if (params.algorithm == "ALL") {
         // Run all algorithms one after another
         // First run with the active scheduler to collect all results
         simulator.run();
@@ -0,0 +1,116 @@
+#include "montecarlo.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include "threadpool.h"
+
+void MetricAccumulator::add(double value) {
+    count++;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+double MetricAccumulator::getVariance() const {
+    return count > 1 ? m2 / (count - 1) : 0.0;
+}
+
+double MetricAccumulator::getHalfWidth95() const {
+    if (count < 2) {
+        return 0.0;
+    }
+    return studentT975(count - 1) * std::sqrt(getVariance() / count);
+}
+
+double studentT975(long long degreesOfFreedom) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    
+    if (degreesOfFreedom <= 0) return 0.0;
+    if (degreesOfFreedom <= 30) return table[degreesOfFreedom - 1];
+    if (degreesOfFreedom <= 40) return 2.021;
+    if (degreesOfFreedom <= 60) return 2.000;
+    if (degreesOfFreedom <= 120) return 1.980;
+    return 1.960;
+}
+
+MonteCarloRunner::MonteCarloRunner(const SimulationParams& simulationParams, const GeneratorSpec& generatorSpec)
+    : params(simulationParams), spec(generatorSpec) {
+    params.verboseMode = false;
+    params.detailedMode = false;
+}
+
+bool MonteCarloRunner::run() {
+    std::vector<std::string> algorithms;
+    if (params.algorithm == "ALL") {
+        algorithms = Simulator::algorithmNames();
+    } else {
+        algorithms = {params.algorithm};
+    }
+    
+    const int replications = params.replications;
+    std::vector<std::vector<RunSummary>> results(replications);
+    
+    {
+        ThreadPool pool(params.threads);
+        for (int r = 0; r < replications; r++) {
+            pool.submit([this, r, &algorithms, &results] {
+                // Each replication owns its generator, so results do not depend on thread timing
+                WorkloadGenerator generator(spec, WorkloadGenerator::replicationSeed(params.seed, r));
+                auto workload = generator.generate();
+                
+                for (const auto& algorithm : algorithms) {
+                    std::vector<std::shared_ptr<Process>> processes;
+                    processes.reserve(workload.size());
+                    for (const auto& process : workload) {
+                        processes.push_back(std::make_shared<Process>(*process));
+                    }
+                    
+                    Simulator simulator(spec.contextSwitchTime);
+                    simulator.initialize(processes);
+                    SimulationParams jobParams = params;
+                    jobParams.algorithm = algorithm;
+                    simulator.setParams(jobParams);
+                    simulator.run();
+                    results[r].push_back(simulator.summarize());
+                }
+            });
+        }
+        pool.wait();
+    }
+    
+    std::cout << "Monte Carlo: " << replications << " replications, seed " << params.seed << "\n"
+              << "Workload spec: " << spec.toString() << "\n";
+    
+    for (size_t a = 0; a < algorithms.size(); a++) {
+        MetricAccumulator totalTime, utilization, switches, turnaround, waiting;
+        for (int r = 0; r < replications; r++) {
+            const RunSummary& summary = results[r][a];
+            totalTime.add(summary.totalTime);
+            utilization.add(summary.cpuUtilization);
+            switches.add(summary.contextSwitches);
+            turnaround.add(summary.avgTurnaround);
+            waiting.add(summary.avgWaiting);
+        }
+        
+        std::cout << "\n" << results[0][a].name << " Results:\n"
+                  << std::left << std::setw(22) << "  Metric" << std::right << std::setw(14) << "Mean"
+                  << std::setw(16) << "95% CI (+/-)" << "\n";
+        
+        auto printMetric = [](const std::string& label, const MetricAccumulator& metric) {
+            std::cout << std::left << std::setw(22) << ("  " + label) << std::right << std::fixed
+                      << std::setprecision(2) << std::setw(14) << metric.getMean()
+                      << std::setw(16) << metric.getHalfWidth95() << "\n";
+        };
+        printMetric("Total Time", totalTime);
+        printMetric("CPU Utilization (%)", utilization);
+        printMetric("Context Switches", switches);
+        printMetric("Avg Turnaround", turnaround);
+        printMetric("Avg Waiting", waiting);
+    }
+    
+    return true;
+}
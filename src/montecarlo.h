@@ -0,0 +1,45 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include <string>
+#include <vector>
+#include "simulator.h"
+#include "workloadgen.h"
+
+// Running mean and variance (Welford's algorithm)
+class MetricAccumulator {
+private:
+    long long count;
+    double mean;
+    double m2;
+    
+public:
+    MetricAccumulator() : count(0), mean(0.0), m2(0.0) {}
+    
+    void add(double value);
+    long long getCount() const { return count; }
+    double getMean() const { return mean; }
+    double getVariance() const;
+    
+    // Half-width of the 95% confidence interval of the mean (Student's t)
+    double getHalfWidth95() const;
+};
+
+// Two-sided 97.5% quantile of Student's t distribution
+double studentT975(long long degreesOfFreedom);
+
+// Replicated Monte Carlo runs: R independent workloads generated in memory
+// from a base seed and a distribution spec, each simulated under every
+// selected algorithm on the thread pool; reports mean and 95% CI per metric
+class MonteCarloRunner {
+private:
+    SimulationParams params;
+    GeneratorSpec spec;
+    
+public:
+    MonteCarloRunner(const SimulationParams& simulationParams, const GeneratorSpec& generatorSpec);
+    
+    bool run();
+};
+
+#endif // MONTECARLO_H
@@ -0,0 +1,257 @@
+#include "multicore.h"
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include "threadpool.h"
+
+MultiCoreRunner::MultiCoreRunner(const SimulationParams& simulationParams,
+                                 const std::vector<std::shared_ptr<Process>>& processList, int switchTime,
+                                 const Topology& hostTopology)
+    : params(simulationParams), processes(processList), contextSwitchTime(switchTime), topology(hostTopology) {
+}
+
+// Copy of a process whose CPU bursts take 'percent' longer (rounded up)
+static std::shared_ptr<Process> stretchCPUBursts(const Process& process, int percent) {
+    // Everything but the bursts (group, predecessors, ...) is kept as placed locally
+    auto copy = std::make_shared<Process>(process);
+    if (auto behavior = process.getBehavior()) {
+        copy->setBehavior(behavior->stretched(percent), (process.getTotalBursts() + 1) / 2);
+        return copy;
+    }
+    
+    std::vector<Burst> bursts = process.getBursts();
+    for (auto& burst : bursts) {
+        if (burst.type == BurstType::CPU) {
+            burst = Burst(BurstType::CPU, (burst.duration * (100 + percent) + 99) / 100);
+        }
+    }
+    copy->setBursts(bursts);
+    return copy;
+}
+
+bool MultiCoreRunner::run() {
+    std::vector<std::string> algorithms;
+    if (params.algorithm == "ALL") {
+        algorithms = Simulator::algorithmNames();
+    } else {
+        algorithms = {params.algorithm};
+    }
+    
+    // One thread simulates every core in turn (the sequential engine)
+    std::unique_ptr<ThreadPool> pool;
+    if (params.threads != 1) {
+        pool = std::make_unique<ThreadPool>(params.threads);
+    }
+    
+    for (const auto& algorithm : algorithms) {
+        runAlgorithm(algorithm, pool.get());
+    }
+    
+    return true;
+}
+
+void MultiCoreRunner::runAlgorithm(const std::string& algorithm, ThreadPool* pool) {
+    const int coreCount = params.cores;
+    const int window = params.placementWindow > 0 ? params.placementWindow : std::max(1, contextSwitchTime);
+    
+    std::vector<Core> cores(coreCount);
+    for (int c = 0; c < coreCount; c++) {
+        SimulationParams coreParams = params;
+        coreParams.algorithm = algorithm;
+        coreParams.seed = params.seed + c;   // Independent lottery draws per core
+        coreParams.verboseMode = false;
+        coreParams.telemetryWindow = 0;
+        
+        cores[c].simulator = std::make_unique<Simulator>(contextSwitchTime);
+        cores[c].simulator->setOutput(nullptr);
+        cores[c].simulator->initialize({});
+        cores[c].simulator->setParams(coreParams);
+        cores[c].simulator->start();
+    }
+    
+    // Logical processes: contiguous groups of cores, one per worker thread
+    size_t groups = pool ? std::min(pool->getThreadCount(), static_cast<size_t>(coreCount)) : 1;
+    auto forEachGroup = [&](const std::function<void(Core&)>& step) {
+        if (groups <= 1) {
+            for (auto& core : cores) {
+                step(core);
+            }
+            return;
+        }
+        for (size_t g = 0; g < groups; g++) {
+            size_t first = g * coreCount / groups;
+            size_t last = (g + 1) * coreCount / groups;
+            pool->submit([&cores, &step, first, last] {
+                for (size_t c = first; c < last; c++) {
+                    step(cores[c]);
+                }
+            });
+        }
+        pool->wait();
+    };
+    
+    // Arrivals in time order (input order among equal times)
+    std::vector<size_t> order(processes.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return processes[a]->getArrivalTime() < processes[b]->getArrivalTime();
+    });
+    
+    // Runs work on copies: placement may stretch bursts or fix the memory node
+    std::vector<std::shared_ptr<Process>> runProcesses(processes.size());
+    std::vector<bool> remote(processes.size(), false);
+    
+    std::vector<int> load(coreCount);
+    size_t next = 0;
+    while (next < order.size()) {
+        // Windows without arrivals need no synchronization and are skipped
+        int windowStart = processes[order[next]]->getArrivalTime() / window * window;
+        if (windowStart > 0) {
+            forEachGroup([windowStart](Core& core) { core.simulator->runUntil(windowStart - 1); });
+        }
+        
+        for (int c = 0; c < coreCount; c++) {
+            load[c] = cores[c].simulator->getProcessCount() - cores[c].simulator->getCompletedCount();
+        }
+        
+        // Join the shortest queue as seen at the window start
+        for (; next < order.size() && processes[order[next]]->getArrivalTime() < windowStart + window; next++) {
+            size_t index = order[next];
+            const Process& process = *processes[index];
+            int target = static_cast<int>(std::min_element(load.begin(), load.end()) - load.begin());
+            int node = process.getMemoryNode();
+            
+            if (topology.isDefined() && node >= 0) {
+                // Stay on the home socket unless it is clearly busier
+                auto homeBegin = load.begin() + node * topology.coresPerSocket;
+                int home = static_cast<int>(std::min_element(homeBegin, homeBegin + topology.coresPerSocket) -
+                                            load.begin());
+                if (load[home] - load[target] <= topology.imbalance) {
+                    target = home;
+                }
+                remote[index] = topology.socketOf(target) != node;
+            }
+            
+            if (remote[index]) {
+                runProcesses[index] = stretchCPUBursts(process, topology.remoteSlowdown);
+            } else {
+                runProcesses[index] = std::make_shared<Process>(process);
+                if (topology.isDefined() && node < 0) {
+                    runProcesses[index]->setMemoryNode(topology.socketOf(target));   // First touch
+                }
+            }
+            
+            cores[target].simulator->addArrival(runProcesses[index]);
+            cores[target].placed.push_back(index);
+            load[target]++;
+        }
+    }
+    
+    forEachGroup([](Core& core) { core.simulator->finish(); });
+    
+    // Aggregate over cores
+    int totalTime = 0;
+    long long busyTime = 0;
+    long long contextSwitches = 0;
+    for (const auto& core : cores) {
+        auto scheduler = core.simulator->getActiveScheduler();
+        totalTime = std::max(totalTime, scheduler->getTotalTime());
+        busyTime += scheduler->getCpuBusyTime();
+        contextSwitches += scheduler->getContextSwitchCount();
+    }
+    
+    double totalTurnaround = 0.0;
+    double totalWaiting = 0.0;
+    for (const auto& process : runProcesses) {
+        totalTurnaround += process->getTurnaroundTime();
+        totalWaiting += process->getWaitingTime();
+    }
+    double count = processes.empty() ? 1.0 : static_cast<double>(processes.size());
+    
+    std::cout << "\n" << cores.front().simulator->getActiveScheduler()->getName() << " Results ("
+              << coreCount << " cores, placement window " << window << "):\n"
+              << "Total Time: " << totalTime << " time units\n"
+              << "CPU Utilization: " << std::fixed << std::setprecision(2)
+              << (totalTime > 0 ? 100.0 * busyTime / (static_cast<double>(totalTime) * coreCount) : 0.0) << "%\n"
+              << "Context Switches: " << contextSwitches << "\n"
+              << "Average Turnaround Time: " << totalTurnaround / count << "\n"
+              << "Average Waiting Time: " << totalWaiting / count << "\n";
+    
+    std::cout << "  Core  Processes   Busy Time  Utilization  Switches  Finish Time\n";
+    for (int c = 0; c < coreCount; c++) {
+        auto scheduler = cores[c].simulator->getActiveScheduler();
+        int coreTime = scheduler->getTotalTime();
+        std::cout << std::setw(6) << c << std::setw(11) << cores[c].placed.size()
+                  << std::setw(12) << scheduler->getCpuBusyTime()
+                  << std::setw(12) << (totalTime > 0 ? 100.0 * scheduler->getCpuBusyTime() / totalTime : 0.0) << "%"
+                  << std::setw(10) << scheduler->getContextSwitchCount()
+                  << std::setw(13) << coreTime << "\n";
+    }
+    
+    if (topology.isDefined()) {
+        long long localTime = 0;
+        long long remoteTime = 0;
+        long long slowdownTime = 0;
+        int remoteProcesses = 0;
+        for (size_t i = 0; i < processes.size(); i++) {
+            if (remote[i]) {
+                remoteTime += runProcesses[i]->getServiceTime();
+                // Behaviors draw their bursts during the run, so their base demand is derived
+                long long base = processes[i]->getBehavior()
+                    ? runProcesses[i]->getServiceTime() * 100 / (100 + topology.remoteSlowdown)
+                    : processes[i]->getServiceTime();
+                slowdownTime += runProcesses[i]->getServiceTime() - base;
+                remoteProcesses++;
+            } else {
+                localTime += runProcesses[i]->getServiceTime();
+            }
+        }
+        
+        std::cout << "NUMA (" << topology.sockets << " sockets x " << topology.coresPerSocket
+                  << " cores, remote slowdown " << topology.remoteSlowdown << "%):\n"
+                  << "  Local CPU Time: " << localTime << " time units ("
+                  << processes.size() - remoteProcesses << " processes)\n"
+                  << "  Remote CPU Time: " << remoteTime << " time units (" << remoteProcesses
+                  << " processes, " << slowdownTime << " of them remote slowdown)\n";
+    }
+    
+    // Every core has its own governor; cores that finished early idle until the last one does
+    if (cores.front().simulator->getDvfsAccounting()) {
+        double energy = 0.0;
+        for (const auto& core : cores) {
+            const DvfsAccounting* accounting = core.simulator->getDvfsAccounting();
+            int coreTime = core.simulator->getActiveScheduler()->getTotalTime();
+            energy += accounting->getEnergy() + accounting->getModel().idleDraw() * (totalTime - coreTime);
+        }
+        std::cout << "Energy (" << cores.front().simulator->getDvfsAccounting()->getModel().describe() << ", per core):\n"
+                  << "  Energy: " << energy << " (power x time units)\n"
+                  << "  Average Power: " << (totalTime > 0 ? energy / totalTime : 0.0) << "\n"
+                  << "  Energy-Delay Product: " << energy * totalTime << " (energy x total time)\n";
+    }
+    std::cout << "\n";
+    
+    if (params.detailedMode) {
+        std::vector<int> coreOf(processes.size());
+        for (int c = 0; c < coreCount; c++) {
+            for (size_t index : cores[c].placed) {
+                coreOf[index] = c;
+            }
+        }
+        
+        std::cout << "Process Details:\n";
+        for (size_t i = 0; i < processes.size(); i++) {
+            const auto& process = runProcesses[i];
+            std::cout << "Process " << process->getId() << ":\n"
+                      << "  Core: " << coreOf[i] << (remote[i] ? " (remote)" : "") << "\n"
+                      << "  Arrival Time: " << process->getArrivalTime() << "\n"
+                      << "  Service Time: " << process->getServiceTime() << "\n"
+                      << "  I/O Time: " << process->getIOTime() << "\n"
+                      << "  Finish Time: " << process->getFinishTime() << "\n"
+                      << "  Turnaround Time: " << process->getTurnaroundTime() << "\n"
+                      << "  Waiting Time: " << process->getWaitingTime() << "\n\n";
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef MULTICORE_H
+#define MULTICORE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "process.h"
+#include "simulator.h"
+
+// Largest simulated host
+const int MAX_CORES = 4096;
+
+// Default NUMA parameters: extra CPU time of a burst run away from its
+// memory node (percent), and the load difference that justifies it
+const int DEFAULT_REMOTE_SLOWDOWN = 30;
+const int DEFAULT_NUMA_IMBALANCE = 2;
+
+// Host topology declared on the input header line (sockets=2
+// cores_per_socket=16 ...). Core c belongs to socket c / coresPerSocket, and
+// each socket is one memory node.
+struct Topology {
+    int sockets;             // 0 = no topology (uniform memory)
+    int coresPerSocket;
+    int remoteSlowdown;      // Percent added to CPU bursts on a remote socket
+    int imbalance;           // Unfinished processes more on the home socket before going remote
+    
+    Topology()
+        : sockets(0), coresPerSocket(0), remoteSlowdown(DEFAULT_REMOTE_SLOWDOWN),
+          imbalance(DEFAULT_NUMA_IMBALANCE) {}
+    
+    bool isDefined() const { return sockets > 0; }
+    int getCoreCount() const { return sockets * coresPerSocket; }
+    int socketOf(int core) const { return core / coresPerSocket; }
+};
+
+// Multi-core model: N simulated cores, each running its own instance of the
+// selected scheduler on the processes placed on it. A global dispatcher puts
+// every arriving process on the core with the fewest unfinished processes,
+// judged from the core states at the start of the placement window the
+// arrival falls into (the lookahead, by default one context switch time).
+//
+// Cores are partitioned into logical processes, one per worker thread, that
+// advance independently to the next window boundary and then synchronize
+// (conservative windowed synchronization). Nothing crosses cores inside a
+// window, so results do not depend on the number of threads.
+//
+// With a topology, placement prefers the least loaded core of the process's
+// memory node (the first socket it lands on if no node is given) and goes
+// remote only when that socket is busier by more than the imbalance; CPU
+// bursts of remotely placed processes are stretched by the remote slowdown.
+class MultiCoreRunner {
+private:
+    SimulationParams params;
+    std::vector<std::shared_ptr<Process>> processes;
+    int contextSwitchTime;
+    Topology topology;
+    
+    struct Core {
+        std::unique_ptr<Simulator> simulator;
+        std::vector<size_t> placed;   // Indexes into processes
+    };
+    
+    void runAlgorithm(const std::string& algorithm, class ThreadPool* pool);
+    
+public:
+    MultiCoreRunner(const SimulationParams& simulationParams,
+                    const std::vector<std::shared_ptr<Process>>& processList, int switchTime,
+                    const Topology& hostTopology = Topology());
+    
+    bool run();
+};
+
+#endif // MULTICORE_H
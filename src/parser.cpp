@@ -2,11 +2,213 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include "jobs.h"
+#include "tuner.h"
 
 Parser::Parser(std::istream& in) : input(in) {
 }
 
+// Split a "key=value" attribute with an integer value
+static bool splitAttribute(const std::string& attribute, std::string& key, long& value) {
+    size_t eq = attribute.find('=');
+    if (eq == std::string::npos || eq + 1 == attribute.size()) {
+        return false;
+    }
+    
+    char* end = nullptr;
+    key = attribute.substr(0, eq);
+    value = std::strtol(attribute.c_str() + eq + 1, &end, 10);
+    return *end == '\0';
+}
+
+bool Parser::parseHeader(Topology& topology, int& cgroupCount, MemoryConfig& memory) {
+    // Process lines start with a digit, header attributes with a letter
+    while ((input >> std::ws) && std::isalpha(input.peek())) {
+        std::string attribute, key;
+        long value;
+        input >> attribute;
+        
+        if (!splitAttribute(attribute, key, value)) {
+            std::cerr << "Error: Invalid header attribute '" << attribute << "'" << std::endl;
+            return false;
+        }
+        
+        if (key == "sockets" || key == "cores_per_socket") {
+            if (value < 1 || value > MAX_CORES) {
+                std::cerr << "Error: " << key << " must be in 1.." << MAX_CORES << std::endl;
+                return false;
+            }
+            (key == "sockets" ? topology.sockets : topology.coresPerSocket) = static_cast<int>(value);
+        } else if (key == "remote_slowdown" || key == "imbalance") {
+            if (value < 0 || value > 1000) {
+                std::cerr << "Error: " << key << " must be in 0..1000" << std::endl;
+                return false;
+            }
+            (key == "remote_slowdown" ? topology.remoteSlowdown : topology.imbalance) = static_cast<int>(value);
+        } else if (key == "cgroups") {
+            if (value < 1 || value > MAX_CGROUPS) {
+                std::cerr << "Error: cgroups must be in 1.." << MAX_CGROUPS << std::endl;
+                return false;
+            }
+            cgroupCount = static_cast<int>(value);
+        } else if (key == "memory" || key == "swap_rate") {
+            if (value < 1 || value > MAX_MEMORY) {
+                std::cerr << "Error: " << key << " must be in 1.." << MAX_MEMORY << std::endl;
+                return false;
+            }
+            (key == "memory" ? memory.capacity : memory.swapRate) = static_cast<int>(value);
+        } else {
+            std::cerr << "Error: Unknown header attribute '" << key << "'" << std::endl;
+            return false;
+        }
+    }
+    
+    if ((topology.sockets > 0) != (topology.coresPerSocket > 0) ||
+        static_cast<long long>(topology.sockets) * topology.coresPerSocket > MAX_CORES) {
+        std::cerr << "Error: A topology needs sockets and cores_per_socket (at most " << MAX_CORES
+                  << " cores in total)" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+bool Parser::parseCgroups(CgroupHierarchy& cgroups, int count) {
+    // One line per group: id parent weight quota period
+    for (int i = 0; i < count; i++) {
+        int id, parent, weight, quota, period;
+        if (!(input >> id >> parent >> weight >> quota >> period)) {
+            std::cerr << "Error: Expected " << count << " cgroup lines (id parent weight quota period)" << std::endl;
+            return false;
+        }
+        if (!cgroups.add(id, parent, weight, quota, period)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool Parser::parseAttributes(Process& process, int& behaviorPhases, long& behaviorSeed) {
+    // Burst numbers start with a digit, attributes with a letter
+    while ((input >> std::ws) && std::isalpha(input.peek())) {
+        std::string attribute, key;
+        long value;
+        input >> attribute;
+        
+        if (!splitAttribute(attribute, key, value)) {
+            std::cerr << "Error: Invalid attribute '" << attribute << "' for process " << process.getId() << std::endl;
+            return false;
+        }
+        
+        if (key == "priority") {
+            if (value < 0 || value >= PRIORITY_LEVELS) {
+                std::cerr << "Error: Priority of process " << process.getId() << " must be in 0.."
+                          << PRIORITY_LEVELS - 1 << std::endl;
+                return false;
+            }
+            process.setPriority(static_cast<int>(value));
+        } else if (key == "tickets") {
+            if (value < 1 || value > MAX_TICKETS) {
+                std::cerr << "Error: Tickets of process " << process.getId() << " must be in 1.."
+                          << MAX_TICKETS << std::endl;
+                return false;
+            }
+            process.setTickets(static_cast<int>(value));
+        } else if (key == "node") {
+            if (value < 0 || value >= MAX_CORES) {
+                std::cerr << "Error: Memory node of process " << process.getId() << " must be in 0.."
+                          << MAX_CORES - 1 << std::endl;
+                return false;
+            }
+            process.setMemoryNode(static_cast<int>(value));
+        } else if (key == "behavior") {
+            if (value < 1 || value > MAX_BEHAVIOR_PHASES) {
+                std::cerr << "Error: Behavior of process " << process.getId() << " must have 1.."
+                          << MAX_BEHAVIOR_PHASES << " phases" << std::endl;
+                return false;
+            }
+            behaviorPhases = static_cast<int>(value);
+        } else if (key == "seed") {
+            if (value < 0) {
+                std::cerr << "Error: Invalid seed for process " << process.getId() << std::endl;
+                return false;
+            }
+            behaviorSeed = value;
+        } else if (key == "group") {
+            if (value < 0 || value > std::numeric_limits<int>::max()) {
+                std::cerr << "Error: Invalid group for process " << process.getId() << std::endl;
+                return false;
+            }
+            process.setGroup(static_cast<int>(value));
+        } else if (key == "after") {
+            if (value <= 0 || value > std::numeric_limits<int>::max()) {
+                std::cerr << "Error: Invalid dependency for process " << process.getId() << std::endl;
+                return false;
+            }
+            process.addPredecessor(static_cast<int>(value));
+        } else if (key == "cgroup") {
+            if (value < 0 || value > std::numeric_limits<int>::max()) {
+                std::cerr << "Error: Invalid cgroup for process " << process.getId() << std::endl;
+                return false;
+            }
+            process.setCgroup(static_cast<int>(value));
+        } else if (key == "memory") {
+            if (value < 0 || value > MAX_MEMORY) {
+                std::cerr << "Error: Memory of process " << process.getId() << " must be in 0.."
+                          << MAX_MEMORY << std::endl;
+                return false;
+            }
+            process.setMemorySize(static_cast<int>(value));
+        } else {
+            std::cerr << "Error: Unknown attribute '" << key << "' for process " << process.getId() << std::endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool Parser::parseBehavior(Process& process, int numBursts, int phaseCount, long seed) {
+    // One line per phase: length min_cpu max_cpu min_io max_io
+    std::vector<BehaviorPhase> phases(phaseCount);
+    for (auto& phase : phases) {
+        input >> phase.length >> phase.minCPU >> phase.maxCPU >> phase.minIO >> phase.maxIO;
+    }
+    
+    if (!input || !BurstBehavior::isValid(phases)) {
+        std::cerr << "Error: Invalid behavior phases for process " << process.getId() << std::endl;
+        return false;
+    }
+    
+    unsigned long long behaviorSeed = seed >= 0 ? static_cast<unsigned long long>(seed) : process.getId();
+    process.setBehavior(std::make_shared<BurstBehavior>(phases, behaviorSeed), numBursts);
+    return true;
+}
+
 bool Parser::parse(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime) {
+    Topology topology;
+    return parse(processes, contextSwitchTime, topology);
+}
+
+bool Parser::parse(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime,
+                   Topology& topology) {
+    CgroupHierarchy cgroups;
+    return parse(processes, contextSwitchTime, topology, cgroups);
+}
+
+bool Parser::parse(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime,
+                   Topology& topology, CgroupHierarchy& cgroups) {
+    MemoryConfig memory;
+    return parse(processes, contextSwitchTime, topology, cgroups, memory);
+}
+
+bool Parser::parse(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime,
+                   Topology& topology, CgroupHierarchy& cgroups, MemoryConfig& memory) {
     int numProcesses;
     
     // Read number of processes and context switch time
@@ -17,6 +219,13 @@ bool Parser::parse(std::vector<std::shared_ptr<Process>>& processes, int& contex
         return false;
     }
     
+    // Optional host topology, cgroup and memory attributes follow on the
+    // header line, and the declared cgroups on the lines after it
+    int cgroupCount = 0;
+    if (!parseHeader(topology, cgroupCount, memory) || !parseCgroups(cgroups, cgroupCount)) {
+        return false;
+    }
+    
     // Read each process
     for (int i = 0; i < numProcesses; i++) {
         int pid, arrivalTime, numBursts;
@@ -32,6 +241,29 @@ bool Parser::parse(std::vector<std::shared_ptr<Process>>& processes, int& contex
         // Create new process
         auto process = std::make_shared<Process>(pid, arrivalTime);
         
+        // Optional key=value attributes follow the burst count
+        int behaviorPhases = 0;
+        long behaviorSeed = -1;
+        if (!parseAttributes(*process, behaviorPhases, behaviorSeed)) {
+            return false;
+        }
+        
+        // Procedural processes list behavior phases instead of their bursts
+        if (behaviorPhases > 0) {
+            if (numBursts > MAX_BEHAVIOR_BURSTS) {
+                std::cerr << "Error: Process " << pid << " may run at most " << MAX_BEHAVIOR_BURSTS
+                          << " CPU bursts" << std::endl;
+                return false;
+            }
+            if (!parseBehavior(*process, numBursts, behaviorPhases, behaviorSeed)) {
+                return false;
+            }
+            numBursts = 0;
+        } else if (behaviorSeed >= 0) {
+            std::cerr << "Error: seed of process " << pid << " requires a behavior" << std::endl;
+            return false;
+        }
+        
         // Read burst information
         for (int j = 0; j < numBursts; j++) {
             int burstNum, cpuTime;
@@ -61,44 +293,357 @@ bool Parser::parse(std::vector<std::shared_ptr<Process>>& processes, int& contex
             }
         }
         
+        if (!cgroups.contains(process->getCgroup())) {
+            std::cerr << "Error: Process " << pid << " is in undeclared cgroup " << process->getCgroup() << std::endl;
+            return false;
+        }
+        
+        if (memory.isDefined() && process->getMemorySize() > memory.capacity) {
+            std::cerr << "Error: Process " << pid << " needs more memory than the host has" << std::endl;
+            return false;
+        }
+        
+        if (process->getMemoryNode() >= std::max(1, topology.sockets)) {
+            std::cerr << "Error: Memory node of process " << pid << " is not a socket of the topology" << std::endl;
+            return false;
+        }
+        
         // Add process to vector
         processes.push_back(process);
     }
     
-    return true;
+    // Dependencies may point forward, so they are checked once all processes are read
+    return validateDependencies(processes);
+}
+
+// Parse a comma-separated list of non-negative integers
+static bool parseIntList(const std::string& text, std::vector<int>& values) {
+    std::stringstream ss(text);
+    std::string item;
+    
+    while (std::getline(ss, item, ',')) {
+        char* end = nullptr;
+        long value = std::strtol(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || value < 0) {
+            return false;
+        }
+        values.push_back(static_cast<int>(value));
+    }
+    
+    return !values.empty();
 }
 
-bool Parser::parseCommandLine(int argc, char* argv[], 
-                             bool& detailedMode, bool& verboseMode, std::string& algorithm) {
+bool Parser::parseCommandLine(int argc, char* argv[], SimulationParams& params) {
     // Default values
-    detailedMode = false;
-    verboseMode = false;
-    algorithm = "ALL";
+    params = SimulationParams();
     
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
         
         if (arg == "-d") {
-            detailedMode = true;
+            params.detailedMode = true;
         } else if (arg == "-v") {
-            verboseMode = true;
+            params.verboseMode = true;
         } else if (arg == "-a" && i + 1 < argc) {
             // Get algorithm name
-            algorithm = argv[++i];
+            params.algorithm = argv[++i];
             
             // Validate algorithm
-            if (algorithm != "FCFS" && algorithm != "SJF" && algorithm != "SRTN" && 
-                algorithm != "RR10" && algorithm != "RR50" && algorithm != "RR100") {
-                std::cerr << "Error: Invalid algorithm. Must be one of: FCFS, SJF, SRTN, RR10, RR50, RR100" << std::endl;
+            const auto& names = Simulator::algorithmNames();
+            if (std::find(names.begin(), names.end(), params.algorithm) == names.end()) {
+                std::cerr << "Error: Invalid algorithm. Must be one of:";
+                for (size_t n = 0; n < names.size(); n++) {
+                    std::cerr << (n == 0 ? " " : ", ") << names[n];
+                }
+                std::cerr << std::endl;
+                return false;
+            }
+        } else if (arg == "-b" && i + 1 < argc) {
+            params.batchInput = argv[++i];
+        } else if (arg == "-o" && i + 1 < argc) {
+            params.batchOutput = argv[++i];
+        } else if (arg == "-j" && i + 1 < argc) {
+            params.threads = std::atoi(argv[++i]);
+            
+            if (params.threads <= 0) {
+                std::cerr << "Error: Invalid thread count: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if ((arg == "-c" || arg == "-F") && i + 1 < argc) {
+            int time = std::atoi(argv[++i]);
+            
+            if (time < 0) {
+                std::cerr << "Error: Invalid checkpoint time: " << argv[i] << std::endl;
+                return false;
+            }
+            (arg == "-c" ? params.checkpointTime : params.forkTime) = time;
+        } else if (arg == "-f" && i + 1 < argc) {
+            params.checkpointFile = argv[++i];
+        } else if (arg == "-r" && i + 1 < argc) {
+            params.restoreFile = argv[++i];
+        } else if ((arg == "-q" || arg == "-s") && i + 1 < argc) {
+            std::vector<int>& values = (arg == "-q") ? params.quantumVariants : params.switchVariants;
+            
+            if (!parseIntList(argv[++i], values) || (arg == "-q" && values.end() != std::find(values.begin(), values.end(), 0))) {
+                std::cerr << "Error: Invalid value list for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-C" && i + 1 < argc) {
+            if (!parseIntList(argv[++i], params.closedClients) ||
+                params.closedClients.end() != std::find(params.closedClients.begin(), params.closedClients.end(), 0)) {
+                std::cerr << "Error: Invalid client counts: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-Z" && i + 1 < argc) {
+            params.thinkTime = std::atof(argv[++i]);
+            
+            if (params.thinkTime < 0.0) {
+                std::cerr << "Error: Invalid think time: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-H" && i + 1 < argc) {
+            params.closedHorizon = std::atoi(argv[++i]);
+            
+            if (params.closedHorizon <= 0) {
+                std::cerr << "Error: Invalid horizon: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-m" && i + 1 < argc) {
+            params.replications = std::atoi(argv[++i]);
+            
+            if (params.replications <= 0) {
+                std::cerr << "Error: Invalid replication count: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-S" && i + 1 < argc) {
+            params.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "-D" && i + 1 < argc) {
+            params.generatorSpec = argv[++i];
+        } else if (arg == "-T" && i + 1 < argc) {
+            params.traceFile = argv[++i];
+        } else if (arg == "-U" && i + 1 < argc) {
+            params.traceMicrosPerUnit = std::atoi(argv[++i]);
+            
+            if (params.traceMicrosPerUnit <= 0) {
+                std::cerr << "Error: Invalid trace time unit: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-E" && i + 1 < argc) {
+            params.exportFile = argv[++i];
+        } else if (arg == "-p" && i + 1 < argc) {
+            params.predictionAlpha = std::atof(argv[++i]);
+            
+            if (params.predictionAlpha <= 0.0 || params.predictionAlpha > 1.0) {
+                std::cerr << "Error: Prediction weight must be in (0, 1]: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-i" && i + 1 < argc) {
+            params.initialPrediction = std::atof(argv[++i]);
+            
+            if (params.initialPrediction <= 0.0) {
+                std::cerr << "Error: Invalid initial burst prediction: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-g" && i + 1 < argc) {
+            params.agingInterval = std::atoi(argv[++i]);
+            
+            if (params.agingInterval < 0) {
+                std::cerr << "Error: Invalid aging interval: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if ((arg == "-l" || arg == "-n") && i + 1 < argc) {
+            int value = std::atoi(argv[++i]);
+            
+            if (value <= 0) {
+                std::cerr << "Error: Invalid " << (arg == "-l" ? "target latency" : "minimum granularity")
+                          << ": " << argv[i] << std::endl;
+                return false;
+            }
+            (arg == "-l" ? params.targetLatency : params.minGranularity) = value;
+        } else if (arg == "-G" && i + 1 < argc) {
+            params.gangSlot = std::atoi(argv[++i]);
+            
+            if (params.gangSlot <= 0) {
+                std::cerr << "Error: Invalid gang slot: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-w" && i + 1 < argc) {
+            params.telemetryWindow = std::atoi(argv[++i]);
+            
+            if (params.telemetryWindow <= 0) {
+                std::cerr << "Error: Invalid telemetry window: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-W" && i + 1 < argc) {
+            params.telemetryFile = argv[++i];
+        } else if (arg == "-e" && i + 1 < argc) {
+            params.steadyStatePrecision = std::atof(argv[++i]);
+            
+            if (params.steadyStatePrecision <= 0.0 || params.steadyStatePrecision >= 1.0) {
+                std::cerr << "Error: Steady-state precision must be in (0, 1): " << argv[i] << std::endl;
+                return false;
+            }
+        } else if ((arg == "-N" || arg == "-L") && i + 1 < argc) {
+            int value = std::atoi(argv[++i]);
+            
+            if (value <= 0 || (arg == "-N" && value > MAX_CORES)) {
+                std::cerr << "Error: Invalid " << (arg == "-N" ? "core count" : "placement window") << ": "
+                          << argv[i] << std::endl;
+                return false;
+            }
+            (arg == "-N" ? params.cores : params.placementWindow) = value;
+        } else if (arg == "-A" && i + 1 < argc) {
+            params.starvationLimit = std::atoi(argv[++i]);
+            
+            if (params.starvationLimit < 0) {
+                std::cerr << "Error: Invalid starvation limit: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "-O" && i + 1 < argc) {
+            params.resultsFile = argv[++i];
+            
+            ResultWriter::Format format;
+            if (!ResultWriter::formatFor(params.resultsFile, format)) {
+                return false;
+            }
+        } else if (arg == "-t" && i + 1 < argc) {
+            params.tuningSpec = argv[++i];
+            
+            TuningSpec spec;
+            if (!spec.parse(params.tuningSpec)) {
+                return false;
+            }
+        } else if (arg == "-P" && i + 1 < argc) {
+            params.dvfsSpec = argv[++i];
+            
+            if (!DvfsModel::create(params.dvfsSpec)) {
+                return false;
+            }
+        } else if (arg == "-R" && i + 1 < argc) {
+            params.cacheDirectory = argv[++i];
+        } else if (arg == "-k" && i + 1 < argc) {
+            params.switchCostSpec = argv[++i];
+            
+            if (!SwitchCostModel::create(params.switchCostSpec)) {
                 return false;
             }
         } else {
             std::cerr << "Error: Invalid argument: " << arg << std::endl;
-            std::cerr << "Usage: sim [-d] [-v] [-a algorithm] < input_file" << std::endl;
+            std::cerr << "Usage: sim [-d] [-v] [-a algorithm] [-p alpha] [-i initial_prediction] [-g aging_interval]" << std::endl;
+            std::cerr << "           [-l target_latency] [-n min_granularity] [-G gang_slot] [-k switch_cost_model]" << std::endl;
+            std::cerr << "           [-w telemetry_window [-W telemetry_file]] [-e precision] [-O results_file]" << std::endl;
+            std::cerr << "           [-A starvation_limit] [-P governor[,settings]] [-R cache_dir] < input_file" << std::endl;
+            std::cerr << "       sim -b manifest|directory [-o results_file] [-j threads] [-a algorithm]" << std::endl;
+            std::cerr << "       sim -a algorithm [-c time -f checkpoint_file] [-F time [-q quanta] [-s switch_times]] < input_file" << std::endl;
+            std::cerr << "       sim -r checkpoint_file [-q quanta] [-s switch_times]" << std::endl;
+            std::cerr << "       sim -m replications [-S seed] [-D spec] [-j threads] [-a algorithm]" << std::endl;
+            std::cerr << "       sim -T trace_file [-U us_per_unit] [-E workload_file] [-d] [-v] [-a algorithm]" << std::endl;
+            std::cerr << "       sim -C clients [-Z think_time] [-H horizon] [-S seed] [-D spec] [-j threads] [-a algorithm]" << std::endl;
+            std::cerr << "       sim -N cores [-L placement_window] [-j threads] [-d] [-a algorithm] < input_file" << std::endl;
+            std::cerr << "       sim -t objective[,settings] [-j threads] [-k switch_cost_model] < input_file" << std::endl;
             return false;
         }
     }
     
+    // Checkpoints capture a single scheduler's run
+    if ((params.checkpointTime >= 0 || params.forkTime >= 0) && params.algorithm == "ALL") {
+        std::cerr << "Error: -c and -F need a single algorithm (-a)" << std::endl;
+        return false;
+    }
+    
+    // Quantum variants replace the fixed quantum of RR10, RR50 or RR100 (a
+    // restored checkpoint's algorithm is checked when it is read)
+    if (!params.quantumVariants.empty() && params.forkTime >= 0 && params.algorithm != "RR10" &&
+        params.algorithm != "RR50" && params.algorithm != "RR100") {
+        std::cerr << "Error: -q needs a fixed-quantum Round Robin algorithm (RR10, RR50 or RR100)" << std::endl;
+        return false;
+    }
+    if (params.checkpointTime >= 0 && params.checkpointFile.empty()) {
+        std::cerr << "Error: -c needs a checkpoint file (-f)" << std::endl;
+        return false;
+    }
+    
+    // Early termination leaves runs that cannot be checkpointed or resumed
+    if (params.steadyStatePrecision > 0.0 &&
+        (params.checkpointTime >= 0 || params.forkTime >= 0 || !params.restoreFile.empty())) {
+        std::cerr << "Error: -e cannot be combined with -c, -F or -r" << std::endl;
+        return false;
+    }
+    
+    // Telemetry streams one run (or the runs of -a ALL) into one file
+    if (params.telemetryWindow > 0 && (!params.batchInput.empty() || params.replications > 0 ||
+                                       params.forkTime >= 0 || !params.quantumVariants.empty() ||
+                                       !params.switchVariants.empty())) {
+        std::cerr << "Error: -w cannot be combined with -b, -m, -F, -q or -s" << std::endl;
+        return false;
+    }
+    
+    // The multi-core model runs its own per-core simulators
+    if (params.cores > 0 && (params.verboseMode || !params.batchInput.empty() || params.replications > 0 ||
+                             params.checkpointTime >= 0 || params.forkTime >= 0 || !params.restoreFile.empty() ||
+                             params.telemetryWindow > 0 || params.steadyStatePrecision > 0.0)) {
+        std::cerr << "Error: -N cannot be combined with -v, -b, -m, -c, -F, -r, -w or -e" << std::endl;
+        return false;
+    }
+    // Closed-loop clients generate their own jobs
+    if (!params.closedClients.empty() && (params.verboseMode || !params.batchInput.empty() || params.replications > 0 ||
+                                          params.checkpointTime >= 0 || params.forkTime >= 0 ||
+                                          !params.restoreFile.empty() || params.telemetryWindow > 0 ||
+                                          params.steadyStatePrecision > 0.0 || params.cores > 0 ||
+                                          !params.traceFile.empty())) {
+        std::cerr << "Error: -C cannot be combined with -v, -b, -m, -c, -F, -r, -w, -e, -N or -T" << std::endl;
+        return false;
+    }
+    
+    // Cached reports stand for a whole run and write nothing besides the report
+    if (!params.cacheDirectory.empty() && (params.verboseMode || !params.batchInput.empty() || params.replications > 0 ||
+                                           params.checkpointTime >= 0 || params.forkTime >= 0 ||
+                                           !params.restoreFile.empty() || params.telemetryWindow > 0 ||
+                                           params.cores > 0 || !params.closedClients.empty())) {
+        std::cerr << "Error: -R cannot be combined with -v, -b, -m, -c, -F, -r, -w, -N or -C" << std::endl;
+        return false;
+    }
+    
+    // Analytics are part of the single-CPU report
+    if (params.starvationLimit >= 0 && (!params.batchInput.empty() || params.replications > 0 ||
+                                        params.cores > 0 || !params.closedClients.empty())) {
+        std::cerr << "Error: -A cannot be combined with -b, -m, -N or -C" << std::endl;
+        return false;
+    }
+    
+    // Per-process results come from the runs of one simulator
+    if (!params.resultsFile.empty() && (!params.batchInput.empty() || params.replications > 0 ||
+                                        params.forkTime >= 0 || !params.restoreFile.empty() ||
+                                        params.cores > 0 || !params.closedClients.empty() ||
+                                        !params.cacheDirectory.empty())) {
+        std::cerr << "Error: -O cannot be combined with -b, -m, -F, -r, -N, -C or -R" << std::endl;
+        return false;
+    }
+    
+    // The tuner runs its own Round Robin simulations and prints only its search
+    if (!params.tuningSpec.empty() && (params.verboseMode || !params.batchInput.empty() || params.replications > 0 ||
+                                       params.checkpointTime >= 0 || params.forkTime >= 0 ||
+                                       !params.restoreFile.empty() || params.telemetryWindow > 0 ||
+                                       params.steadyStatePrecision > 0.0 || params.cores > 0 ||
+                                       !params.closedClients.empty() || !params.resultsFile.empty() ||
+                                       !params.cacheDirectory.empty())) {
+        std::cerr << "Error: -t cannot be combined with -v, -b, -m, -c, -F, -r, -w, -e, -N, -C, -O or -R" << std::endl;
+        return false;
+    }
+    
+    // Frequency and energy are tracked over uninterrupted single-CPU or per-core runs
+    if (!params.dvfsSpec.empty() && (!params.batchInput.empty() || params.replications > 0 ||
+                                     params.checkpointTime >= 0 || params.forkTime >= 0 ||
+                                     !params.restoreFile.empty() || !params.closedClients.empty())) {
+        std::cerr << "Error: -P cannot be combined with -b, -m, -c, -F, -r or -C" << std::endl;
+        return false;
+    }
+    
+    if (params.placementWindow > 0 && params.cores == 0) {
+        std::cerr << "Error: -L requires -N" << std::endl;
+        return false;
+    }
+    
     return true;
-}
\ No newline at end of file
+}
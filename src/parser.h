@@ -6,21 +6,54 @@
 #include <string>
 #include <iostream>
 #include "process.h"
+#include "simulator.h"
+#include "multicore.h"
+#include "cgroup.h"
+#include "hostmemory.h"
 
 // Input Parser class
 class Parser {
 private:
     std::istream& input;
     
+    // Read optional "key=value" process attributes (priority=N, tickets=N,
+    // node=N, behavior=phases with seed=N for procedural bursts, group=G
+    // with any number of after=PID dependencies for jobs, cgroup=ID and the
+    // memory footprint memory=M)
+    bool parseAttributes(Process& process, int& behaviorPhases, long& behaviorSeed);
+    
+    // Read the phase lines of a burst behavior
+    bool parseBehavior(Process& process, int numBursts, int phaseCount, long seed);
+    
+    // Read optional header attributes: host topology (sockets=N,
+    // cores_per_socket=N, remote_slowdown=percent, imbalance=N), the
+    // number of cgroup lines that follow (cgroups=K) and the host memory
+    // (memory=C, swap_rate=R)
+    bool parseHeader(Topology& topology, int& cgroupCount, MemoryConfig& memory);
+    
+    // Read the cgroup lines after the header
+    bool parseCgroups(CgroupHierarchy& cgroups, int count);
+    
 public:
     Parser(std::istream& in);
     
     // Parse input file and return processes and context switch time
     bool parse(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime);
     
+    // Same, also returning the host topology declared in the input (if any)
+    bool parse(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime,
+               Topology& topology);
+    
+    // Same, also returning the cgroup hierarchy declared in the input (if any)
+    bool parse(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime,
+               Topology& topology, CgroupHierarchy& cgroups);
+    
+    // Same, also returning the host memory declared in the input (if any)
+    bool parse(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime,
+               Topology& topology, CgroupHierarchy& cgroups, MemoryConfig& memory);
+    
     // Parse command line arguments
-    static bool parseCommandLine(int argc, char* argv[], 
-                                bool& detailedMode, bool& verboseMode, std::string& algorithm);
+    static bool parseCommandLine(int argc, char* argv[], SimulationParams& params);
 };
 
 #endif // PARSER_H
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "predictor.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+BurstPredictor::BurstPredictor(double weight, double initial)
+    : alpha(weight),
+      initialPrediction(initial),
+      samples(0),
+      errorSum(0.0),
+      absErrorSum(0.0),
+      squaredErrorSum(0.0),
+      actualSum(0.0) {
+}
+
+void BurstPredictor::configure(double weight, double initial) {
+    alpha = weight;
+    initialPrediction = initial;
+}
+
+void BurstPredictor::reset() {
+    predictions.clear();
+    samples = 0;
+    errorSum = 0.0;
+    absErrorSum = 0.0;
+    squaredErrorSum = 0.0;
+    actualSum = 0.0;
+}
+
+double BurstPredictor::predict(const Process& process) const {
+    auto it = predictions.find(process.getId());
+    return it != predictions.end() ? it->second : initialPrediction;
+}
+
+double BurstPredictor::predictRemaining(const Process& process) const {
+    double remaining = predict(process);
+    
+    // The time already run in a CPU burst is known to the kernel
+    if (process.hasCurrentBurst() && process.getCurrentBurst().type == BurstType::CPU) {
+        remaining -= process.getCurrentBurstElapsed();
+    }
+    
+    return std::max(1.0, remaining);
+}
+
+void BurstPredictor::observe(int pid, int actual) {
+    auto it = predictions.find(pid);
+    double tau = it != predictions.end() ? it->second : initialPrediction;
+    
+    double error = tau - actual;
+    samples++;
+    errorSum += error;
+    absErrorSum += std::fabs(error);
+    squaredErrorSum += error * error;
+    actualSum += actual;
+    
+    predictions[pid] = alpha * actual + (1.0 - alpha) * tau;
+}
+
+double BurstPredictor::getMeanError() const {
+    return samples > 0 ? errorSum / samples : 0.0;
+}
+
+double BurstPredictor::getMeanAbsoluteError() const {
+    return samples > 0 ? absErrorSum / samples : 0.0;
+}
+
+double BurstPredictor::getRootMeanSquaredError() const {
+    return samples > 0 ? std::sqrt(squaredErrorSum / samples) : 0.0;
+}
+
+double BurstPredictor::getRelativeError() const {
+    return actualSum > 0.0 ? 100.0 * absErrorSum / actualSum : 0.0;
+}
+
+std::vector<double> BurstPredictor::getState() const {
+    // Parameters and statistics first, then (pid, tau) pairs in pid order for stable output
+    std::vector<double> state = {alpha, initialPrediction, static_cast<double>(samples),
+                                 errorSum, absErrorSum, squaredErrorSum, actualSum};
+    
+    std::vector<std::pair<int, double>> entries(predictions.begin(), predictions.end());
+    std::sort(entries.begin(), entries.end());
+    for (const auto& entry : entries) {
+        state.push_back(entry.first);
+        state.push_back(entry.second);
+    }
+    return state;
+}
+
+bool BurstPredictor::setState(const std::vector<double>& state) {
+    if (state.size() < 7 || (state.size() - 7) % 2 != 0) {
+        return false;
+    }
+    
+    alpha = state[0];
+    initialPrediction = state[1];
+    samples = static_cast<long long>(state[2]);
+    errorSum = state[3];
+    absErrorSum = state[4];
+    squaredErrorSum = state[5];
+    actualSum = state[6];
+    
+    predictions.clear();
+    for (size_t i = 7; i < state.size(); i += 2) {
+        predictions[static_cast<int>(state[i])] = state[i + 1];
+    }
+    return true;
+}
+
+PredictiveScheduler::PredictiveScheduler(const std::string& schedulerName, int switchTime)
+    : Scheduler(schedulerName, switchTime) {
+}
+
+void PredictiveScheduler::onCPUBurstComplete(std::shared_ptr<Process> process, int burstLength) {
+    predictor.observe(process->getId(), burstLength);
+}
+
+void PredictiveScheduler::outputAlgorithmResults(std::ostream& out) const {
+    out << "Burst Prediction (alpha=" << std::fixed << std::setprecision(2) << predictor.getAlpha()
+        << ", initial=" << predictor.getInitialPrediction() << "):\n"
+        << "  Predicted Bursts: " << predictor.getSamples() << "\n"
+        << "  Mean Absolute Error: " << predictor.getMeanAbsoluteError()
+        << " (" << predictor.getRelativeError() << "% of mean burst)\n"
+        << "  Mean Error (bias): " << predictor.getMeanError() << "\n"
+        << "  RMS Error: " << predictor.getRootMeanSquaredError() << "\n";
+}
@@ -0,0 +1,69 @@
+#ifndef PREDICTOR_H
+#define PREDICTOR_H
+
+#include <unordered_map>
+#include "scheduler.h"
+
+// Exponential-average CPU burst predictor
+// tau(n+1) = alpha * t(n) + (1 - alpha) * tau(n), kept per process. Only
+// observed burst lengths and time already run are used, never the future
+// bursts stored in Process.
+class BurstPredictor {
+private:
+    double alpha;
+    double initialPrediction;
+    std::unordered_map<int, double> predictions;   // Process ID -> tau
+    
+    // Prediction error statistics
+    long long samples;
+    double errorSum;
+    double absErrorSum;
+    double squaredErrorSum;
+    double actualSum;
+    
+public:
+    BurstPredictor(double weight = 0.5, double initial = 100.0);
+    
+    void configure(double weight, double initial);
+    void reset();
+    double getAlpha() const { return alpha; }
+    double getInitialPrediction() const { return initialPrediction; }
+    
+    // Predicted length of the process's current (or next) CPU burst
+    double predict(const Process& process) const;
+    
+    // Predicted time left in the current burst, never below one unit
+    double predictRemaining(const Process& process) const;
+    
+    // Record an observed burst length and update the process's average
+    void observe(int pid, int actual);
+    
+    long long getSamples() const { return samples; }
+    double getMeanError() const;
+    double getMeanAbsoluteError() const;
+    double getRootMeanSquaredError() const;
+    double getRelativeError() const;   // MAE / mean burst, in percent
+    
+    std::vector<double> getState() const;
+    bool setState(const std::vector<double>& state);
+};
+
+// Base class of schedulers that order processes by predicted bursts
+class PredictiveScheduler : public Scheduler {
+protected:
+    BurstPredictor predictor;
+    
+public:
+    PredictiveScheduler(const std::string& schedulerName, int switchTime);
+    
+    void configurePredictor(double alpha, double initial) { predictor.configure(alpha, initial); }
+    const BurstPredictor& getPredictor() const { return predictor; }
+    
+    void onCPUBurstComplete(std::shared_ptr<Process> process, int burstLength) override;
+    void outputAlgorithmResults(std::ostream& out) const override;
+    void resetPolicyState() override { predictor.reset(); }
+    std::vector<double> getPolicyState() const override { return predictor.getState(); }
+    bool setPolicyState(const std::vector<double>& state) override { return predictor.setState(state); }
+};
+
+#endif // PREDICTOR_H
@@ -0,0 +1,185 @@
+#include "priority.h"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <unordered_map>
+
+static_assert(PRIORITY_LEVELS <= 64, "priority bitmap holds at most 64 levels");
+
+PriorityScheduler::PriorityScheduler(int contextSwitchTime, int aging)
+    : Scheduler("Priority with aging", contextSwitchTime),
+      bitmap(0),
+      readyCount(0),
+      runningLevel(PRIORITY_LEVELS),
+      agingInterval(aging) {
+}
+
+int PriorityScheduler::firstLevel(uint64_t bits) {
+    return __builtin_ctzll(bits);
+}
+
+void PriorityScheduler::enqueue(const Entry& entry) {
+    queues[entry.level].push_back(entry);
+    bitmap |= uint64_t(1) << entry.level;
+    readyCount++;
+}
+
+void PriorityScheduler::addProcess(std::shared_ptr<Process> process) {
+    enqueue({process, process->getPriority(), 0});
+    process->setState(ProcessState::READY);
+}
+
+std::shared_ptr<Process> PriorityScheduler::getNextProcess() {
+    if (bitmap == 0) {
+        return nullptr;
+    }
+    
+    // Highest non-empty level, oldest process within it
+    int level = firstLevel(bitmap);
+    std::shared_ptr<Process> next = queues[level].front().process;
+    queues[level].pop_front();
+    if (queues[level].empty()) {
+        bitmap &= ~(uint64_t(1) << level);
+    }
+    readyCount--;
+    runningLevel = level;
+    
+    return next;
+}
+
+bool PriorityScheduler::shouldPreempt(std::shared_ptr<Process> newProcess) {
+    // If there's no current process, no need to preempt
+    if (!hasCpuProcess()) {
+        return false;
+    }
+    
+    // Newly ready processes enter at their static priority
+    return newProcess->getPriority() < runningLevel;
+}
+
+void PriorityScheduler::updateWaitingTime(int timeElapsed) {
+    // Visit levels from highest to lowest; promoted entries land on levels
+    // already visited, so each process is charged exactly once
+    for (uint64_t bits = bitmap; bits != 0; bits &= bits - 1) {
+        int level = firstLevel(bits);
+        std::deque<Entry>& queue = queues[level];
+        
+        size_t count = queue.size();
+        for (size_t i = 0; i < count; i++) {
+            Entry entry = queue.front();
+            queue.pop_front();
+            entry.process->incrementWaitingTime(timeElapsed);
+            entry.credit += timeElapsed;
+            
+            if (agingInterval > 0 && entry.level > 0 && entry.credit >= agingInterval) {
+                entry.level = std::max(0, entry.level - entry.credit / agingInterval);
+                entry.credit %= agingInterval;
+                readyCount--;
+                enqueue(entry);
+            } else {
+                queue.push_back(entry);
+            }
+        }
+        
+        if (queue.empty()) {
+            bitmap &= ~(uint64_t(1) << level);
+        }
+    }
+}
+
+std::vector<std::shared_ptr<Process>> PriorityScheduler::getReadyProcesses() const {
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(readyCount);
+    for (uint64_t bits = bitmap; bits != 0; bits &= bits - 1) {
+        for (const auto& entry : queues[firstLevel(bits)]) {
+            processes.push_back(entry.process);
+        }
+    }
+    return processes;
+}
+
+void PriorityScheduler::outputAlgorithmResults(std::ostream& out) const {
+    if (agingInterval > 0) {
+        out << "Aging: one level per " << agingInterval << " time units waited\n";
+    } else {
+        out << "Aging: off\n";
+    }
+    
+    // Waiting time per static priority class
+    struct ClassStats {
+        int processes = 0;
+        long long totalWaiting = 0;
+        int maxWaiting = 0;
+    };
+    std::map<int, ClassStats> classes;
+    for (const auto& process : allProcesses) {
+        ClassStats& stats = classes[process->getPriority()];
+        stats.processes++;
+        stats.totalWaiting += process->getWaitingTime();
+        stats.maxWaiting = std::max(stats.maxWaiting, process->getWaitingTime());
+    }
+    
+    out << "Waiting Time by Priority:\n"
+        << "  Priority  Processes  Avg Waiting  Max Waiting\n";
+    for (const auto& entry : classes) {
+        out << "  " << std::setw(8) << entry.first
+            << "  " << std::setw(9) << entry.second.processes
+            << "  " << std::setw(11) << std::fixed << std::setprecision(2)
+            << static_cast<double>(entry.second.totalWaiting) / entry.second.processes
+            << "  " << std::setw(11) << entry.second.maxWaiting << "\n";
+    }
+}
+
+void PriorityScheduler::resetPolicyState() {
+    for (auto& queue : queues) {
+        queue.clear();
+    }
+    bitmap = 0;
+    readyCount = 0;
+    runningLevel = PRIORITY_LEVELS;
+}
+
+std::vector<double> PriorityScheduler::getPolicyState() const {
+    // Aging interval and running level, then (pid, level, credit) per ready
+    // process in getReadyProcesses() order
+    std::vector<double> state = {static_cast<double>(agingInterval), static_cast<double>(runningLevel)};
+    for (uint64_t bits = bitmap; bits != 0; bits &= bits - 1) {
+        for (const auto& entry : queues[firstLevel(bits)]) {
+            state.push_back(entry.process->getId());
+            state.push_back(entry.level);
+            state.push_back(entry.credit);
+        }
+    }
+    return state;
+}
+
+bool PriorityScheduler::setPolicyState(const std::vector<double>& state) {
+    // The ready processes were already added at their static priorities;
+    // move them back to the levels and credits they had
+    if (state.size() < 2 || (state.size() - 2) % 3 != 0 || (state.size() - 2) / 3 != readyCount) {
+        return false;
+    }
+    
+    std::unordered_map<int, std::shared_ptr<Process>> ready;
+    for (const auto& process : getReadyProcesses()) {
+        ready[process->getId()] = process;
+    }
+    
+    std::vector<Entry> entries;
+    for (size_t i = 2; i < state.size(); i += 3) {
+        auto it = ready.find(static_cast<int>(state[i]));
+        int level = static_cast<int>(state[i + 1]);
+        if (it == ready.end() || level < 0 || level >= PRIORITY_LEVELS) {
+            return false;
+        }
+        entries.push_back({it->second, level, static_cast<int>(state[i + 2])});
+    }
+    
+    resetPolicyState();
+    agingInterval = static_cast<int>(state[0]);
+    runningLevel = static_cast<int>(state[1]);
+    for (const auto& entry : entries) {
+        enqueue(entry);
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef PRIORITY_H
+#define PRIORITY_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include "scheduler.h"
+
+// Priority Scheduler with aging (Preemptive)
+// Ready processes live in one FIFO queue per priority level; a bitmap marks
+// the non-empty levels, so picking the next process is one find-first-set
+// (as in the Linux O(1) scheduler). A process that waits agingInterval time
+// units in the ready queue moves up one level; it drops back to its static
+// priority when it next becomes ready.
+class PriorityScheduler : public Scheduler {
+private:
+    struct Entry {
+        std::shared_ptr<Process> process;
+        int level;
+        int credit;     // Waiting time not yet converted into a promotion
+    };
+    
+    std::array<std::deque<Entry>, PRIORITY_LEVELS> queues;
+    uint64_t bitmap;    // Bit i set = queues[i] not empty
+    size_t readyCount;
+    int runningLevel;   // Level the running process was dispatched from
+    int agingInterval;  // 0 = no aging
+    
+    void enqueue(const Entry& entry);
+    static int firstLevel(uint64_t bits);
+    
+public:
+    PriorityScheduler(int contextSwitchTime, int aging);
+    
+    // Implementation of abstract methods
+    void addProcess(std::shared_ptr<Process> process) override;
+    std::shared_ptr<Process> getNextProcess() override;
+    bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
+    bool isPreemptive() const override { return true; }
+    void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    size_t getReadyQueueSize() const override { return readyCount; }
+    
+    // Waiting time by priority class, aging state in checkpoints
+    void outputAlgorithmResults(std::ostream& out) const override;
+    void resetPolicyState() override;
+    std::vector<double> getPolicyState() const override;
+    bool setPolicyState(const std::vector<double>& state) override;
+    
+    // Priority specific methods
+    int getAgingInterval() const { return agingInterval; }
+    void setAgingInterval(int aging) { agingInterval = aging; }
+};
+
+#endif // PRIORITY_H
@@ -1,9 +1,21 @@
 #include "process.h"
+#include <algorithm>
 
 Process::Process(int pid, int arrival) :
     id(pid),
     arrivalTime(arrival),
+    priority(DEFAULT_PRIORITY),
+    tickets(DEFAULT_TICKETS),
+    memoryNode(-1),
+    memorySize(0),
+    group(-1),
+    cgroup(0),
+    releaseTime(arrival),
+    bursts(std::make_shared<std::vector<Burst>>()),
+    totalBursts(0),
+    behaviorState(),
     currentBurst(0),
+    currentRemaining(0),
     state(ProcessState::NEW),
     serviceTime(0),
     ioTime(0),
@@ -13,13 +25,115 @@ Process::Process(int pid, int arrival) :
 }
 
 void Process::addCPUBurst(int duration) {
-    bursts.push_back(Burst(BurstType::CPU, duration));
+    if (bursts.use_count() > 1) {
+        bursts = std::make_shared<std::vector<Burst>>(*bursts);
+    }
+    bursts->push_back(Burst(BurstType::CPU, duration));
+    totalBursts++;
     serviceTime += duration;
+    if (bursts->size() == 1) {
+        currentRemaining = duration;
+    }
 }
 
 void Process::addIOBurst(int duration) {
-    bursts.push_back(Burst(BurstType::IO, duration));
+    if (bursts.use_count() > 1) {
+        bursts = std::make_shared<std::vector<Burst>>(*bursts);
+    }
+    bursts->push_back(Burst(BurstType::IO, duration));
+    totalBursts++;
+    ioTime += duration;
+}
+
+void Process::addPredecessor(int pid) {
+    auto updated = predecessors ? std::make_shared<std::vector<int>>(*predecessors)
+                                : std::make_shared<std::vector<int>>();
+    updated->push_back(pid);
+    predecessors = updated;
+}
+
+const std::vector<int>& Process::getPredecessors() const {
+    static const std::vector<int> none;
+    return predecessors ? *predecessors : none;
+}
+
+void Process::setBehavior(std::shared_ptr<const BurstBehavior> burstBehavior, int cpuBursts) {
+    behavior = burstBehavior;
+    bursts = std::make_shared<std::vector<Burst>>();
+    totalBursts = 2 * cpuBursts - 1;
+    reset();
+}
+
+void Process::setBursts(const std::vector<Burst>& burstList) {
+    behavior = nullptr;
+    bursts = std::make_shared<std::vector<Burst>>(burstList);
+    totalBursts = static_cast<int>(burstList.size());
+    serviceTime = 0;
+    ioTime = 0;
+    for (const auto& burst : burstList) {
+        (burst.type == BurstType::CPU ? serviceTime : ioTime) += burst.duration;
+    }
+    reset();
+}
+
+Burst Process::drawBurst(int index) {
+    // Bursts alternate CPU (even indexes) and I/O
+    if (index % 2 == 0) {
+        int duration = behavior->nextCPUBurst(behaviorState);
+        serviceTime += duration;
+        return Burst(BurstType::CPU, duration);
+    }
+    int duration = behavior->nextIOBurst(behaviorState);
     ioTime += duration;
+    return Burst(BurstType::IO, duration);
+}
+
+Burst Process::getCurrentBurst() const {
+    Burst burst = burstAt(currentBurst);
+    burst.remaining = currentRemaining;
+    return burst;
+}
+
+void Process::reset() {
+    currentBurst = 0;
+    releaseTime = arrivalTime;
+    if (behavior) {
+        // Start the behavior over; totals grow again as bursts are drawn
+        behaviorState = behavior->start();
+        serviceTime = 0;
+        ioTime = 0;
+        window[0] = drawBurst(0);
+        if (totalBursts > 1) {
+            window[1] = drawBurst(1);
+        }
+        currentRemaining = window[0].duration;
+    } else {
+        currentRemaining = bursts->empty() ? 0 : bursts->front().duration;
+    }
+    state = ProcessState::NEW;
+    finishTime = 0;
+    turnaroundTime = 0;
+    waitingTime = 0;
+}
+
+void Process::restoreProgress(int burstIndex, int remaining, ProcessState newState,
+                              int finish, int waiting) {
+    if (behavior) {
+        // Replay the behavior up to the burst
+        reset();
+        while (currentBurst < burstIndex && hasCurrentBurst()) {
+            advanceBurst();
+        }
+    }
+    currentBurst = burstIndex;
+    currentRemaining = remaining;
+    state = newState;
+    finishTime = finish;
+    waitingTime = waiting;
+    turnaroundTime = 0;
+    if (finishTime > 0) {
+        calculateStatistics();
+    }
 }
 
 void Process::setState(ProcessState newState) {
@@ -27,46 +141,64 @@ void Process::setState(ProcessState newState) {
 }
 
 void Process::advanceBurst() {
-    if (currentBurst < static_cast<int>(bursts.size()) - 1) {
+    // Moving past the last burst leaves currentBurst == totalBursts,
+    // which is how callers detect that the process has finished
+    if (currentBurst < totalBursts) {
         currentBurst++;
+        if (behavior && hasCurrentBurst()) {
+            window[0] = window[1];
+            if (hasNextBurst()) {
+                window[1] = drawBurst(currentBurst + 1);
+            }
+        }
+        currentRemaining = hasCurrentBurst() ? burstAt(currentBurst).duration : 0;
     }
 }
 
 void Process::updateRemainingTime(int time) {
-    if (currentBurst < static_cast<int>(bursts.size())) {
-        bursts[currentBurst].remaining -= time;
-        if (bursts[currentBurst].remaining < 0) {
-            bursts[currentBurst].remaining = 0;
+    if (hasCurrentBurst()) {
+        currentRemaining -= time;
+        if (currentRemaining < 0) {
+            currentRemaining = 0;
         }
     }
 }
 
 int Process::getRemainingCPUTime() const {
+    // With a behavior only the bursts drawn so far are known
+    int known = behavior ? std::min(totalBursts, currentBurst + 2) : totalBursts;
     int remaining = 0;
-    for (size_t i = currentBurst; i < bursts.size(); i++) {
-        if (bursts[i].type == BurstType::CPU) {
-            remaining += (i == static_cast<size_t>(currentBurst)) ? bursts[i].remaining : bursts[i].duration;
+    for (int i = currentBurst; i < known; i++) {
+        if (burstAt(i).type == BurstType::CPU) {
+            remaining += (i == currentBurst) ? currentRemaining : burstAt(i).duration;
         }
     }
     return remaining;
 }
 
 int Process::getRemainingTime() const {
-    if (currentBurst >= static_cast<int>(bursts.size())) {
+    if (!hasCurrentBurst()) {
+        return 0;
+    }
+    return currentRemaining;
+}
+
+int Process::getCurrentBurstElapsed() const {
+    if (!hasCurrentBurst()) {
         return 0;
     }
-    return bursts[currentBurst].remaining;
+    return burstAt(currentBurst).duration - currentRemaining;
 }
 
 int Process::getNextCPUBurstTime() const {
-    if (currentBurst < static_cast<int>(bursts.size()) && 
-        bursts[currentBurst].type == BurstType::CPU) {
-        return bursts[currentBurst].remaining;
+    if (hasCurrentBurst() && burstAt(currentBurst).type == BurstType::CPU) {
+        return currentRemaining;
     }
     
-    for (size_t i = currentBurst + 1; i < bursts.size(); i++) {
-        if (bursts[i].type == BurstType::CPU) {
-            return bursts[i].duration;
+    int known = behavior ? std::min(totalBursts, currentBurst + 2) : totalBursts;
+    for (int i = currentBurst + 1; i < known; i++) {
+        if (burstAt(i).type == BurstType::CPU) {
+            return burstAt(i).duration;
         }
     }
     
@@ -84,7 +216,7 @@ void Process::setFinishTime(int time) {
 void Process::calculateStatistics() {
     // Only calculate if we have a valid finish time
     if (finishTime > 0) {
-        turnaroundTime = finishTime - arrivalTime;
+        turnaroundTime = finishTime - releaseTime;
         waitingTime = turnaroundTime - (serviceTime + ioTime);
         
         if (waitingTime < 0) {
@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <string>
+#include <memory>
+#include "behavior.h"
 
 // Process states
 enum class ProcessState {
@@ -34,25 +36,65 @@ struct Burst {
     int duration;
     int remaining;
     
+    Burst() : type(BurstType::CPU), duration(0), remaining(0) {}
     Burst(BurstType t, int d) : type(t), duration(d), remaining(d) {}
 };
 
+// Static priorities: 0 is the highest, PRIORITY_LEVELS - 1 the lowest
+const int PRIORITY_LEVELS = 40;
+const int DEFAULT_PRIORITY = 20;
+
+// Proportional-share tickets (lottery and stride scheduling)
+const int DEFAULT_TICKETS = 100;
+const int MAX_TICKETS = 1000000;
+
+// Burst lists are immutable once a process is built and are shared between
+// copies of a process (copy-on-write); only the progress of the current
+// burst is stored per copy, so copying a process is O(1)
+//
+// A process may instead follow a BurstBehavior: its bursts are drawn when
+// reached and only the current burst and the next one (the peek buffer that
+// keeps next-burst lookahead working) are held, so it needs O(1) memory
+// however many bursts it runs. Its service and I/O totals cover the bursts
+// drawn so far, which is all of them once it terminates.
+
 // Process structure
 class Process {
 private:
     int id;
     int arrivalTime;
-    std::vector<Burst> bursts;
+    int priority;
+    int tickets;
+    int memoryNode;      // NUMA node of the process memory (-1 = first touch)
+    int memorySize;      // Memory footprint that must be resident to run (0 = none)
+    int group;           // Job (process group) the process belongs to (-1 = none)
+    int cgroup;          // Control group charged for its CPU time (0 = root)
+    std::shared_ptr<const std::vector<int>> predecessors;   // Must terminate first (nullptr = none)
+    int releaseTime;     // When the process became eligible to run (arrival or last predecessor)
+    std::shared_ptr<std::vector<Burst>> bursts;
+    int totalBursts;
+    
+    // Procedural bursts (nullptr = stored burst list)
+    std::shared_ptr<const BurstBehavior> behavior;
+    BehaviorState behaviorState;
+    Burst window[2];         // Current and next burst
+    
     int currentBurst;
+    int currentRemaining;    // Remaining time of the current burst
     ProcessState state;
     
     // Statistics
     int serviceTime;     // Total CPU time
     int ioTime;          // Total I/O time
     int finishTime;      // Time when process terminated
-    int turnaroundTime;  // Finish time - arrival time
+    int turnaroundTime;  // Finish time - release time
     int waitingTime;     // Time spent in ready queue
     
+    const Burst& burstAt(int index) const {
+        return behavior ? window[index - currentBurst] : (*bursts)[index];
+    }
+    Burst drawBurst(int index);
+    
 public:
     Process(int pid, int arrival);
     
@@ -60,20 +102,55 @@ public:
     void addCPUBurst(int duration);
     void addIOBurst(int duration);
     
+    // Draw the bursts from a behavior instead: cpuBursts CPU bursts with I/O between them
+    void setBehavior(std::shared_ptr<const BurstBehavior> burstBehavior, int cpuBursts);
+    std::shared_ptr<const BurstBehavior> getBehavior() const { return behavior; }
+    
+    // Replace the stored bursts (CPU, I/O, ..., CPU) and start over
+    void setBursts(const std::vector<Burst>& burstList);
+    
     // Getters
     int getId() const { return id; }
     int getArrivalTime() const { return arrivalTime; }
+    int getPriority() const { return priority; }
+    void setPriority(int value) { priority = value; }
+    int getTickets() const { return tickets; }
+    void setTickets(int value) { tickets = value; }
+    int getMemoryNode() const { return memoryNode; }
+    void setMemoryNode(int node) { memoryNode = node; }
+    int getMemorySize() const { return memorySize; }
+    void setMemorySize(int size) { memorySize = size; }
+    int getGroup() const { return group; }
+    void setGroup(int value) { group = value; }
+    int getCgroup() const { return cgroup; }
+    void setCgroup(int id) { cgroup = id; }
+    
+    // Dependency edges: the process is released once all predecessors terminated
+    void addPredecessor(int pid);
+    bool hasPredecessors() const { return predecessors != nullptr; }
+    const std::vector<int>& getPredecessors() const;
+    int getReleaseTime() const { return releaseTime; }
+    void setReleaseTime(int time) { releaseTime = time; }
     ProcessState getState() const { return state; }
     int getCurrentBurstIndex() const { return currentBurst; }
-    const Burst& getCurrentBurst() const { return bursts[currentBurst]; }
-    Burst& getCurrentBurstRef() { return bursts[currentBurst]; }
-    bool hasNextBurst() const { return currentBurst + 1 < (int)bursts.size(); }
-    const Burst& getNextBurst() const { return bursts[currentBurst + 1]; }
+    bool hasCurrentBurst() const { return currentBurst < totalBursts; }
+    Burst getCurrentBurst() const;
+    bool hasNextBurst() const { return currentBurst + 1 < totalBursts; }
+    const Burst& getNextBurst() const { return burstAt(currentBurst + 1); }
+    const std::vector<Burst>& getBursts() const { return *bursts; }   // Empty with a behavior
     int getRemainingCPUTime() const;
     int getRemainingTime() const;
-    int getTotalBursts() const { return bursts.size(); }
+    int getCurrentBurstElapsed() const;  // Time already run in the current burst
+    int getTotalBursts() const { return totalBursts; }
     int getNextCPUBurstTime() const;
     
+    // Restore the process to its freshly parsed state (used between runs)
+    void reset();
+    
+    // Restore mid-run progress (used when resuming from a checkpoint)
+    void restoreProgress(int burstIndex, int remaining, ProcessState newState,
+                         int finish, int waiting);
+    
     // State transitions
     void setState(ProcessState newState);
     void advanceBurst();
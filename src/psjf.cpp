@@ -0,0 +1,45 @@
+#include "psjf.h"
+
+PSJFScheduler::PSJFScheduler(int contextSwitchTime)
+    : PredictiveScheduler("Shortest Job First (predicted)", contextSwitchTime) {
+}
+
+void PSJFScheduler::addProcess(std::shared_ptr<Process> process) {
+    readyQueue.push_back(process);
+    process->setState(ProcessState::READY);
+}
+
+std::shared_ptr<Process> PSJFScheduler::getNextProcess() {
+    if (readyQueue.empty()) {
+        return nullptr;
+    }
+    
+    // Find the process with the shortest predicted CPU burst
+    auto shortestIt = std::min_element(
+        readyQueue.begin(), readyQueue.end(),
+        [this](const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) {
+            return predictor.predictRemaining(*a) < predictor.predictRemaining(*b);
+        }
+    );
+    
+    std::shared_ptr<Process> shortestProcess = *shortestIt;
+    readyQueue.erase(shortestIt);
+    
+    return shortestProcess;
+}
+
+bool PSJFScheduler::shouldPreempt(std::shared_ptr<Process>) {
+    // PSJF is non-preemptive, so always return false
+    return false;
+}
+
+void PSJFScheduler::updateWaitingTime(int timeElapsed) {
+    // Update waiting time for all processes in the ready queue
+    for (auto& process : readyQueue) {
+        process->incrementWaitingTime(timeElapsed);
+    }
+}
+
+std::vector<std::shared_ptr<Process>> PSJFScheduler::getReadyProcesses() const {
+    return readyQueue;
+}
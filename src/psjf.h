@@ -0,0 +1,30 @@
+#ifndef PSJF_H
+#define PSJF_H
+
+#include <vector>
+#include <algorithm>
+#include "predictor.h"
+
+// Shortest Job First with predicted bursts (Non-preemptive)
+// Orders processes by the exponential average of their past CPU bursts
+// instead of the true length of the next burst.
+class PSJFScheduler : public PredictiveScheduler {
+private:
+    std::vector<std::shared_ptr<Process>> readyQueue;
+    
+public:
+    PSJFScheduler(int contextSwitchTime);
+    
+    // Implementation of abstract methods
+    void addProcess(std::shared_ptr<Process> process) override;
+    std::shared_ptr<Process> getNextProcess() override;
+    bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
+    bool isPreemptive() const override { return false; }
+    void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    
+    // PSJF specific methods
+    size_t getReadyQueueSize() const override { return readyQueue.size(); }
+};
+
+#endif // PSJF_H
@@ -0,0 +1,50 @@
+#include "psrtn.h"
+
+PSRTNScheduler::PSRTNScheduler(int contextSwitchTime)
+    : PredictiveScheduler("Shortest Remaining Time Next (predicted)", contextSwitchTime) {
+}
+
+void PSRTNScheduler::addProcess(std::shared_ptr<Process> process) {
+    readyQueue.push_back(process);
+    process->setState(ProcessState::READY);
+}
+
+std::shared_ptr<Process> PSRTNScheduler::getNextProcess() {
+    if (readyQueue.empty()) {
+        return nullptr;
+    }
+    
+    // Find the process with the shortest predicted remaining time
+    auto shortestIt = std::min_element(
+        readyQueue.begin(), readyQueue.end(),
+        [this](const std::shared_ptr<Process>& a, const std::shared_ptr<Process>& b) {
+            return predictor.predictRemaining(*a) < predictor.predictRemaining(*b);
+        }
+    );
+    
+    std::shared_ptr<Process> shortestProcess = *shortestIt;
+    readyQueue.erase(shortestIt);
+    
+    return shortestProcess;
+}
+
+bool PSRTNScheduler::shouldPreempt(std::shared_ptr<Process> newProcess) {
+    // If there's no current process, no need to preempt
+    if (!hasCpuProcess()) {
+        return false;
+    }
+    
+    // Preempt if the new process is predicted to finish its burst sooner
+    return predictor.predictRemaining(*newProcess) < predictor.predictRemaining(*currentProcess);
+}
+
+void PSRTNScheduler::updateWaitingTime(int timeElapsed) {
+    // Update waiting time for all processes in the ready queue
+    for (auto& process : readyQueue) {
+        process->incrementWaitingTime(timeElapsed);
+    }
+}
+
+std::vector<std::shared_ptr<Process>> PSRTNScheduler::getReadyProcesses() const {
+    return readyQueue;
+}
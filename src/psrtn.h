@@ -0,0 +1,30 @@
+#ifndef PSRTN_H
+#define PSRTN_H
+
+#include <vector>
+#include <algorithm>
+#include "predictor.h"
+
+// Shortest Remaining Time Next with predicted bursts (Preemptive)
+// Orders processes by predicted burst length minus the time already run
+// in the burst, instead of the true remaining time.
+class PSRTNScheduler : public PredictiveScheduler {
+private:
+    std::vector<std::shared_ptr<Process>> readyQueue;
+    
+public:
+    PSRTNScheduler(int contextSwitchTime);
+    
+    // Implementation of abstract methods
+    void addProcess(std::shared_ptr<Process> process) override;
+    std::shared_ptr<Process> getNextProcess() override;
+    bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
+    bool isPreemptive() const override { return true; }
+    void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    
+    // PSRTN specific methods
+    size_t getReadyQueueSize() const override { return readyQueue.size(); }
+};
+
+#endif // PSRTN_H
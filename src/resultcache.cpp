@@ -0,0 +1,168 @@
+#include "resultcache.h"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include "switchcost.h"
+#include "workloadgen.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    // 64-bit FNV-1a of a string
+    unsigned long long fnv1a(const std::string& text) {
+        unsigned long long hash = 0xcbf29ce484222325ULL;
+        for (unsigned char c : text) {
+            hash = (hash ^ c) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+    
+    // Stream buffer that digests what is written to it instead of keeping it:
+    // FNV-1a and a multiply-xorshift hash side by side give 128 bits
+    class DigestBuffer : public std::streambuf {
+    private:
+        unsigned long long first = 0xcbf29ce484222325ULL;
+        unsigned long long second = 0x243f6a8885a308d3ULL;
+        
+        void add(unsigned char c) {
+            first = (first ^ c) * 0x100000001b3ULL;
+            second = (second ^ c) * 0x9e3779b97f4a7c15ULL;
+            second ^= second >> 29;
+        }
+    
+    protected:
+        int_type overflow(int_type c) override {
+            if (c != traits_type::eof()) {
+                add(static_cast<unsigned char>(c));
+            }
+            return traits_type::not_eof(c);
+        }
+        
+        std::streamsize xsputn(const char* data, std::streamsize count) override {
+            for (std::streamsize i = 0; i < count; i++) {
+                add(static_cast<unsigned char>(data[i]));
+            }
+            return count;
+        }
+    
+    public:
+        std::string hex() const {
+            std::ostringstream out;
+            out << std::hex << std::setfill('0') << std::setw(16) << first << std::setw(16) << second;
+            return out.str();
+        }
+    };
+}
+
+ResultCache::ResultCache(const std::string& cacheDirectory) : directory(cacheDirectory) {
+}
+
+std::string ResultCache::entryPath(const std::string& key) const {
+    std::ostringstream name;
+    name << std::hex << std::setfill('0') << std::setw(16) << fnv1a(key) << ".txt";
+    return (fs::path(directory) / name.str()).string();
+}
+
+std::string ResultCache::makeKey(const std::vector<std::shared_ptr<Process>>& processes, int contextSwitchTime,
+                                 const CgroupHierarchy& cgroups, const MemoryConfig& memory,
+                                 const SimulationParams& params) {
+    // Workload in the input format, then the control groups it refers to and the host memory
+    DigestBuffer digest;
+    std::ostream workload(&digest);
+    WorkloadGenerator::write(workload, processes, contextSwitchTime);
+    for (size_t g = 0; g < cgroups.size(); g++) {
+        const auto& group = cgroups.at(static_cast<int>(g));
+        workload << "cgroup " << group.id << " " << group.parent << " " << group.weight << " "
+                 << group.quota << " " << group.period << "\n";
+    }
+    for (const auto& process : processes) {
+        if (process->getCgroup() != 0) {
+            workload << "member " << process->getId() << " " << process->getCgroup() << "\n";
+        }
+    }
+    if (memory.isDefined()) {
+        workload << "memory " << memory.capacity << " " << memory.swapRate << "\n";
+    }
+    workload.flush();
+    
+    std::string switchCost = params.switchCostSpec;
+    if (auto model = SwitchCostModel::create(params.switchCostSpec)) {
+        switchCost = model->describe();
+    }
+    std::string dvfs;
+    if (!params.dvfsSpec.empty()) {
+        if (auto model = DvfsModel::create(params.dvfsSpec)) {
+            dvfs = model->describe();
+        }
+    }
+    
+    std::ostringstream key;
+    key << std::setprecision(17)
+        << "version=" << SIMULATOR_VERSION << "\n"
+        << "algorithm=" << params.algorithm << "\n"
+        << "detailed=" << params.detailedMode << "\n"
+        << "batch_events=" << params.batchEvents << "\n"
+        << "prediction=" << params.predictionAlpha << "," << params.initialPrediction << "\n"
+        << "aging=" << params.agingInterval << "\n"
+        << "seed=" << params.seed << "\n"
+        << "adaptive=" << params.targetLatency << "," << params.minGranularity << "\n"
+        << "gang_slot=" << params.gangSlot << "\n"
+        << "switch_cost=" << switchCost << "\n"
+        << "steady_state=" << params.steadyStatePrecision << "\n"
+        << "starvation_limit=" << params.starvationLimit << "\n"
+        << "dvfs=" << dvfs << "\n"
+        << "workload=" << digest.hex() << "\n";
+    return key.str();
+}
+
+bool ResultCache::lookup(const std::string& key, std::string& report) const {
+    std::ifstream input(entryPath(key), std::ios::binary);
+    if (!input) {
+        return false;
+    }
+    
+    // "key <length>", the key itself, then the report
+    std::string tag;
+    size_t length = 0;
+    if (!(input >> tag >> length) || tag != "key" || input.get() != '\n' || length != key.size()) {
+        return false;
+    }
+    std::string storedKey(length, '\0');
+    if (!input.read(&storedKey[0], static_cast<std::streamsize>(length)) || storedKey != key) {
+        return false;
+    }
+    
+    std::ostringstream contents;
+    contents << input.rdbuf();
+    report = contents.str();
+    return true;
+}
+
+bool ResultCache::store(const std::string& key, const std::string& report) const {
+    std::error_code error;
+    fs::create_directories(directory, error);
+    
+    std::string path = entryPath(key);
+    std::string temporary = path + ".tmp" + std::to_string(std::random_device{}());
+    {
+        std::ofstream output(temporary, std::ios::binary);
+        output << "key " << key.size() << "\n" << key << report;
+        if (!output) {
+            std::cerr << "Error: Cannot write result cache entry " << temporary << std::endl;
+            fs::remove(temporary, error);
+            return false;
+        }
+    }
+    
+    fs::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Error: Cannot write result cache entry " << path << std::endl;
+        fs::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,42 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "process.h"
+#include "cgroup.h"
+#include "simulator.h"
+
+// On-disk cache of simulation reports (-R directory). A report is addressed
+// by its key: the simulator version, every parameter that shapes the report
+// and a 128-bit digest of the parsed workload (processes, bursts or
+// behaviors, attributes and control groups, in the input format). The
+// workload is digested as it is written, so keys stay small and take
+// constant memory however large the workload is. Each entry is one file
+// named after a hash of the key; it repeats the key, so a hash collision or
+// an entry of another version reads as a miss. Entries are written to a
+// temporary file and renamed, so concurrent runs never see partial reports.
+class ResultCache {
+private:
+    std::string directory;
+    
+    std::string entryPath(const std::string& key) const;
+    
+public:
+    explicit ResultCache(const std::string& cacheDirectory);
+    
+    // Key of a single-CPU run of the workload under the given parameters
+    // (params.algorithm names one algorithm: ALL is stored per algorithm)
+    static std::string makeKey(const std::vector<std::shared_ptr<Process>>& processes, int contextSwitchTime,
+                               const CgroupHierarchy& cgroups, const MemoryConfig& memory,
+                               const SimulationParams& params);
+    
+    // Report stored under the key, if any
+    bool lookup(const std::string& key, std::string& report) const;
+    
+    // Store a report; reports an unwritable directory on std::cerr
+    bool store(const std::string& key, const std::string& report) const;
+};
+
+#endif // RESULTCACHE_H
@@ -0,0 +1,196 @@
+#include "resultwriter.h"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const char* const BINARY_MAGIC = "CPUSIMPR";
+    const uint32_t BINARY_VERSION = 1;
+    const char* const COLUMN_NAMES = "pid,arrival,service,io,finish,turnaround,waiting";
+    const uint32_t COLUMN_COUNT = 7;
+    
+    // Rows are encoded into a chunk that goes to the stream when nearly full
+    const size_t CHUNK_SIZE = 1 << 16;
+    const size_t MAX_ROW_SIZE = 256;
+    
+    void writeUint32(std::ostream& out, uint32_t value) {
+        unsigned char bytes[4];
+        for (int i = 0; i < 4; i++) {
+            bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+        out.write(reinterpret_cast<const char*>(bytes), 4);
+    }
+    
+    void writeUint64(std::ostream& out, uint64_t value) {
+        writeUint32(out, static_cast<uint32_t>(value));
+        writeUint32(out, static_cast<uint32_t>(value >> 32));
+    }
+    
+    void writeString(std::ostream& out, const std::string& text) {
+        writeUint32(out, static_cast<uint32_t>(text.size()));
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    
+    char* appendText(char* at, const char* text) {
+        size_t length = std::strlen(text);
+        std::memcpy(at, text, length);
+        return at + length;
+    }
+    
+    char* appendInt(char* at, int value) {
+        return std::to_chars(at, at + 12, value).ptr;
+    }
+}
+
+void ProcessResultTable::capture(const std::string& runAlgorithm,
+                                 const std::vector<std::shared_ptr<Process>>& processes) {
+    algorithm = runAlgorithm;
+    for (auto* column : {&ids, &arrival, &service, &io, &finish, &turnaround, &waiting}) {
+        column->clear();
+        column->reserve(processes.size());
+    }
+    
+    for (const auto& process : processes) {
+        ids.push_back(process->getId());
+        arrival.push_back(process->getArrivalTime());
+        service.push_back(process->getServiceTime());
+        io.push_back(process->getIOTime());
+        finish.push_back(process->getFinishTime());
+        turnaround.push_back(process->getTurnaroundTime());
+        waiting.push_back(process->getWaitingTime());
+    }
+}
+
+ResultWriter::ResultWriter(const std::string& filePath, Format fileFormat)
+    : path(filePath), format(fileFormat), outputBuffer(1 << 22) {
+    
+    output.rdbuf()->pubsetbuf(outputBuffer.data(), outputBuffer.size());
+    output.open(path, std::ios::binary);
+    if (!output) {
+        std::cerr << "Error: Cannot write results file " << path << std::endl;
+        return;
+    }
+    
+    if (format == Format::CSV) {
+        output << "algorithm," << COLUMN_NAMES << "\n";
+    } else if (format == Format::BINARY) {
+        output.write(BINARY_MAGIC, 8);
+        writeUint32(output, BINARY_VERSION);
+        writeUint32(output, COLUMN_COUNT);
+        writeString(output, COLUMN_NAMES);
+    }
+}
+
+ResultWriter::~ResultWriter() {
+    close();
+}
+
+bool ResultWriter::formatFor(const std::string& filePath, Format& fileFormat) {
+    auto endsWith = [&](const std::string& suffix) {
+        return filePath.size() > suffix.size() &&
+               filePath.compare(filePath.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    
+    if (endsWith(".csv")) {
+        fileFormat = Format::CSV;
+    } else if (endsWith(".jsonl")) {
+        fileFormat = Format::JSONL;
+    } else if (endsWith(".bin")) {
+        fileFormat = Format::BINARY;
+    } else {
+        std::cerr << "Error: Results file must end in .csv, .jsonl or .bin: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void ResultWriter::submit(ProcessResultTable table) {
+    if (!output.is_open()) return;
+    
+    if (pending.valid()) {
+        pending.wait();
+    }
+    auto shared = std::make_shared<ProcessResultTable>(std::move(table));
+    pending = std::async(std::launch::async, [this, shared]() { write(*shared); });
+}
+
+void ResultWriter::write(const ProcessResultTable& table) {
+    if (format == Format::BINARY) {
+        writeBinary(table);
+    } else {
+        writeText(table);
+    }
+}
+
+void ResultWriter::writeText(const ProcessResultTable& table) {
+    std::vector<char> chunk(CHUNK_SIZE);
+    char* at = chunk.data();
+    char* limit = chunk.data() + CHUNK_SIZE - MAX_ROW_SIZE - table.algorithm.size();
+    bool json = format == Format::JSONL;
+    
+    for (size_t row = 0; row < table.size(); row++) {
+        if (at > limit) {
+            output.write(chunk.data(), at - chunk.data());
+            at = chunk.data();
+        }
+        
+        at = appendText(at, json ? "{\"algorithm\":\"" : "");
+        at = appendText(at, table.algorithm.c_str());
+        at = appendText(at, json ? "\",\"pid\":" : ",");
+        at = appendInt(at, table.ids[row]);
+        at = appendText(at, json ? ",\"arrival\":" : ",");
+        at = appendInt(at, table.arrival[row]);
+        at = appendText(at, json ? ",\"service\":" : ",");
+        at = appendInt(at, table.service[row]);
+        at = appendText(at, json ? ",\"io\":" : ",");
+        at = appendInt(at, table.io[row]);
+        at = appendText(at, json ? ",\"finish\":" : ",");
+        at = appendInt(at, table.finish[row]);
+        at = appendText(at, json ? ",\"turnaround\":" : ",");
+        at = appendInt(at, table.turnaround[row]);
+        at = appendText(at, json ? ",\"waiting\":" : ",");
+        at = appendInt(at, table.waiting[row]);
+        at = appendText(at, json ? "}\n" : "\n");
+    }
+    output.write(chunk.data(), at - chunk.data());
+}
+
+void ResultWriter::writeBinary(const ProcessResultTable& table) {
+    writeString(output, table.algorithm);
+    writeUint64(output, table.size());
+    
+    // Columns as little-endian int32 arrays, encoded a chunk at a time
+    std::vector<char> chunk(CHUNK_SIZE);
+    for (const auto* column : {&table.ids, &table.arrival, &table.service, &table.io, &table.finish,
+                               &table.turnaround, &table.waiting}) {
+        size_t used = 0;
+        for (int value : *column) {
+            uint32_t bits = static_cast<uint32_t>(value);
+            for (int i = 0; i < 4; i++) {
+                chunk[used++] = static_cast<char>(bits >> (8 * i));
+            }
+            if (used == CHUNK_SIZE) {
+                output.write(chunk.data(), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+        }
+        output.write(chunk.data(), static_cast<std::streamsize>(used));
+    }
+}
+
+bool ResultWriter::close() {
+    if (!output.is_open()) {
+        return false;
+    }
+    
+    if (pending.valid()) {
+        pending.wait();
+    }
+    output.close();
+    if (!output) {
+        std::cerr << "Error: Cannot write results file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
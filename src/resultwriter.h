@@ -0,0 +1,74 @@
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "process.h"
+
+// Per-process results of one scheduler run, stored column by column
+struct ProcessResultTable {
+    std::string algorithm;
+    std::vector<int> ids;
+    std::vector<int> arrival;
+    std::vector<int> service;
+    std::vector<int> io;
+    std::vector<int> finish;
+    std::vector<int> turnaround;
+    std::vector<int> waiting;
+    
+    // Copy the current results of the processes (taken right after a run,
+    // before the next run resets the shared process objects); -d prints
+    // its Process Details from the same copy
+    void capture(const std::string& runAlgorithm, const std::vector<std::shared_ptr<Process>>& processes);
+    size_t size() const { return ids.size(); }
+};
+
+// Structured per-process results file (-O), one row per process and
+// scheduler run. The format follows the file extension:
+//   .csv    header line, then algorithm,pid,arrival,service,io,finish,turnaround,waiting
+//   .jsonl  one JSON object per row with the same keys
+//   .bin    columnar tables: the magic "CPUSIMPR", uint32 version, uint32
+//           column count, the comma-separated column names (uint32 length +
+//           bytes), then per run the algorithm (uint32 length + bytes), the
+//           uint64 row count and each column as a little-endian int32 array
+// Rows are encoded through a large buffer on a background task, so one run's
+// table is written while the simulator runs the next scheduler. At most one
+// table is in flight: submitting the next waits for the previous write.
+class ResultWriter {
+public:
+    enum class Format { CSV, JSONL, BINARY };
+    
+private:
+    std::string path;
+    Format format;
+    std::ofstream output;
+    std::vector<char> outputBuffer;
+    std::future<void> pending;
+    
+    void write(const ProcessResultTable& table);
+    void writeText(const ProcessResultTable& table);
+    void writeBinary(const ProcessResultTable& table);
+    
+public:
+    ResultWriter(const std::string& filePath, Format fileFormat);
+    ~ResultWriter();
+    
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+    
+    // Format of a results file name; reports unknown extensions on std::cerr
+    static bool formatFor(const std::string& filePath, Format& fileFormat);
+    
+    bool isOpen() const { return output.is_open(); }
+    
+    // Queue a run's table for writing
+    void submit(ProcessResultTable table);
+    
+    // Wait for the last table and flush; reports write errors on std::cerr
+    bool close();
+};
+
+#endif // RESULTWRITER_H
@@ -12,8 +12,17 @@ RRScheduler::RRScheduler(int contextSwitchTime, int quantum)
     name = ss.str();
 }
 
+void RRScheduler::setTimeQuantum(int quantum) {
+    // Takes effect from the next dispatch; a running slice keeps its length
+    timeQuantum = quantum;
+    
+    std::stringstream ss;
+    ss << "Round Robin (quantum=" << quantum << ")";
+    name = ss.str();
+}
+
 void RRScheduler::addProcess(std::shared_ptr<Process> process) {
-    readyQueue.push(process);
+    readyQueue.push_back(process);
     process->setState(ProcessState::READY);
 }
 
@@ -23,7 +32,7 @@ std::shared_ptr<Process> RRScheduler::getNextProcess() {
     }
     
     auto process = readyQueue.front();
-    readyQueue.pop();
+    readyQueue.pop_front();
     
     // Reset time slice for the new process
     resetTimeSlice();
@@ -37,22 +46,12 @@ bool RRScheduler::shouldPreempt(std::shared_ptr<Process> newProcess) {
 }
 
 void RRScheduler::updateWaitingTime(int timeElapsed) {
-    // In RR, we update waiting time for all processes in the ready queue
-    size_t queueSize = readyQueue.size();
-    std::queue<std::shared_ptr<Process>> tempQueue;
-    
-    // Process each element in the queue
-    for (size_t i = 0; i < queueSize; i++) {
-        auto process = readyQueue.front();
-        readyQueue.pop();
-        
-        // Update waiting time
+    // Update waiting time for all processes in the ready queue (in place)
+    for (auto& process : readyQueue) {
         process->incrementWaitingTime(timeElapsed);
-        
-        // Put it back
-        tempQueue.push(process);
     }
-    
-    // Restore the queue
-    readyQueue = tempQueue;
+}
+
+std::vector<std::shared_ptr<Process>> RRScheduler::getReadyProcesses() const {
+    return std::vector<std::shared_ptr<Process>>(readyQueue.begin(), readyQueue.end());
 }
\ No newline at end of file
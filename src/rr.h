@@ -1,13 +1,13 @@
 #ifndef RR_H
 #define RR_H
 
-#include <queue>
+#include <deque>
 #include "scheduler.h"
 
 // Round Robin Scheduler
 class RRScheduler : public Scheduler {
 private:
-    std::queue<std::shared_ptr<Process>> readyQueue;
+    std::deque<std::shared_ptr<Process>> readyQueue;
     int timeQuantum;
     int currentTimeSlice;
     
@@ -20,14 +20,19 @@ public:
     bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
     bool isPreemptive() const override { return true; }
     void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    int getTimeSlice() const override { return currentTimeSlice; }
+    void renewTimeSlice() override { resetTimeSlice(); }
     
     // RR specific methods
     int getTimeQuantum() const { return timeQuantum; }
+    void setTimeQuantum(int quantum);
+    void setCurrentTimeSlice(int slice) { currentTimeSlice = slice; }
     void resetTimeSlice() { currentTimeSlice = timeQuantum; }
     void decrementTimeSlice(int time) { currentTimeSlice -= time; }
     int getCurrentTimeSlice() const { return currentTimeSlice; }
     bool isTimeSliceExpired() const { return currentTimeSlice <= 0; }
-    size_t getReadyQueueSize() const { return readyQueue.size(); }
+    size_t getReadyQueueSize() const override { return readyQueue.size(); }
 };
 
 #endif // RR_H
\ No newline at end of file
@@ -8,6 +8,9 @@ Scheduler::Scheduler(const std::string& schedulerName, int switchTime)
       isCpuBusy(false),
       cpuUtilization(0.0),
       currentProcess(nullptr),
+      switchKindCount(),
+      switchKindTime(),
+      cacheRefillTime(0),
       name(schedulerName) {
 }
 
@@ -36,3 +39,44 @@ double Scheduler::getCpuUtilization() const {
 void Scheduler::addToAllProcesses(std::shared_ptr<Process> process) {
     allProcesses.push_back(process);
 }
+
+void Scheduler::restoreCounters(int busyTime, int switchCount) {
+    cpuBusyTime = busyTime;
+    contextSwitchCount = switchCount;
+}
+
+void Scheduler::recordSwitch(const SwitchCost& cost) {
+    switchKindCount[static_cast<size_t>(cost.kind)]++;
+    switchKindTime[static_cast<size_t>(cost.kind)] += cost.total;
+    cacheRefillTime += cost.refill;
+}
+
+long long Scheduler::getSwitchOverhead() const {
+    long long total = 0;
+    for (long long time : switchKindTime) {
+        total += time;
+    }
+    return total;
+}
+
+std::vector<long long> Scheduler::getSwitchBreakdown() const {
+    // Counts, then times, then cache refill time
+    std::vector<long long> breakdown(switchKindCount.begin(), switchKindCount.end());
+    breakdown.insert(breakdown.end(), switchKindTime.begin(), switchKindTime.end());
+    breakdown.push_back(cacheRefillTime);
+    return breakdown;
+}
+
+bool Scheduler::restoreSwitchBreakdown(const std::vector<long long>& breakdown) {
+    const size_t kinds = switchKindCount.size();
+    if (breakdown.size() != 2 * kinds + 1) {
+        return false;
+    }
+    
+    for (size_t i = 0; i < kinds; i++) {
+        switchKindCount[i] = static_cast<int>(breakdown[i]);
+        switchKindTime[i] = breakdown[kinds + i];
+    }
+    cacheRefillTime = breakdown[2 * kinds];
+    return true;
+}
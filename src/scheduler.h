@@ -5,7 +5,10 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <iostream>
+#include <array>
 #include "process.h"
+#include "switchcost.h"
 
 // Abstract base class for all scheduling algorithms
 class Scheduler {
@@ -19,6 +22,11 @@ protected:
     double cpuUtilization;
     std::shared_ptr<Process> currentProcess;
     
+    // Switch overhead breakdown, indexed by SwitchKind
+    std::array<int, static_cast<size_t>(SwitchKind::COUNT)> switchKindCount;
+    std::array<long long, static_cast<size_t>(SwitchKind::COUNT)> switchKindTime;
+    long long cacheRefillTime;
+    
     // Process collection
     std::vector<std::shared_ptr<Process>> allProcesses;
     
@@ -35,6 +43,29 @@ public:
     virtual bool shouldPreempt(std::shared_ptr<Process> newProcess) = 0;
     virtual bool isPreemptive() const = 0;
     virtual void updateWaitingTime(int timeElapsed) = 0;
+    virtual size_t getReadyQueueSize() const = 0;
+    
+    // Ready queue contents in queue order (for checkpoints)
+    virtual std::vector<std::shared_ptr<Process>> getReadyProcesses() const = 0;
+    
+    // Time slicing: length of the slice granted at each dispatch (0 = run
+    // until the burst ends), renewed in place when nobody else is ready
+    virtual int getTimeSlice() const { return 0; }
+    virtual void renewTimeSlice() {}
+    
+    // Optional policy hooks
+    // Called when a process starts (or keeps) running at the given time
+    virtual void onDispatch(std::shared_ptr<Process>, int) {}
+    // Called with the CPU time a running process used since it was last charged
+    virtual void onCPUTime(std::shared_ptr<Process>, int) {}
+    // Called when a process finishes a CPU burst of the given length
+    virtual void onCPUBurstComplete(std::shared_ptr<Process>, int) {}
+    // Algorithm-specific lines for the results report
+    virtual void outputAlgorithmResults(std::ostream&) const {}
+    // Algorithm-specific state, cleared at the start of each run and saved in checkpoints
+    virtual void resetPolicyState() {}
+    virtual std::vector<double> getPolicyState() const { return {}; }
+    virtual bool setPolicyState(const std::vector<double>& state) { return state.empty(); }
     
     // Common methods
     void setCurrentProcess(std::shared_ptr<Process> process);
@@ -59,6 +90,17 @@ public:
     void incrementCpuBusyTime(int time) { cpuBusyTime += time; }
     void incrementContextSwitchCount() { contextSwitchCount++; }
     void setCpuUtilization(double util) { cpuUtilization = util; }
+    void setContextSwitchTime(int time) { contextSwitchTime = time; }
+    void restoreCounters(int busyTime, int switchCount);
+    
+    // Switch overhead breakdown
+    void recordSwitch(const SwitchCost& cost);
+    int getSwitchCount(SwitchKind kind) const { return switchKindCount[static_cast<size_t>(kind)]; }
+    long long getSwitchTime(SwitchKind kind) const { return switchKindTime[static_cast<size_t>(kind)]; }
+    long long getSwitchOverhead() const;
+    long long getCacheRefillTime() const { return cacheRefillTime; }
+    std::vector<long long> getSwitchBreakdown() const;
+    bool restoreSwitchBreakdown(const std::vector<long long>& breakdown);
 };
 
 #endif // SCHEDULER_H
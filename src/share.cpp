@@ -0,0 +1,192 @@
+#include "share.h"
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+ShareScheduler::ShareScheduler(int contextSwitchTime, int quantum)
+    : Scheduler("Hierarchical Share", contextSwitchTime),
+      timeQuantum(quantum) {
+    
+    // Append time quantum to the name
+    std::stringstream ss;
+    ss << "Hierarchical Share (quantum=" << quantum << ")";
+    name = ss.str();
+    
+    buildNodes();
+}
+
+void ShareScheduler::setHierarchy(std::shared_ptr<const CgroupHierarchy> groups) {
+    hierarchy = groups;
+    buildNodes();
+}
+
+void ShareScheduler::buildNodes() {
+    size_t groupCount = hierarchy ? hierarchy->size() : 0;
+    nodes.assign(1 + groupCount, Node{-1, 1, StridePass(), 0, 0, {}});
+    for (size_t g = 0; g < groupCount; g++) {
+        const auto& spec = hierarchy->at(static_cast<int>(g));
+        nodes[g + 1].parent = spec.parent + 1;
+        nodes[g + 1].weight = spec.weight;
+    }
+}
+
+int ShareScheduler::nodeOf(const Process& process) const {
+    return hierarchy ? hierarchy->indexOf(process.getCgroup()) + 1 : 0;
+}
+
+void ShareScheduler::enqueue(std::shared_ptr<Process> process, bool catchUp) {
+    int node = nodeOf(*process);
+    StridePass& pass = passes[process->getId()];
+    if (catchUp) {
+        pass.value = std::max(pass.value, nodes[node].virtualTime);
+    }
+    nodes[node].queue.insert({pass.value, -static_cast<long long>(process->getId())});
+    readyProcesses[process->getId()] = process;
+    
+    // Groups that just got their first ready process join their parent's queue
+    for (int n = node; n >= 0; n = nodes[n].parent) {
+        if (++nodes[n].ready > 1 || nodes[n].parent < 0) continue;
+        Node& parent = nodes[nodes[n].parent];
+        if (catchUp) {
+            nodes[n].pass.value = std::max(nodes[n].pass.value, parent.virtualTime);
+        }
+        parent.queue.insert({nodes[n].pass.value, n});
+    }
+}
+
+void ShareScheduler::addProcess(std::shared_ptr<Process> process) {
+    enqueue(process, true);
+    process->setState(ProcessState::READY);
+}
+
+std::shared_ptr<Process> ShareScheduler::getNextProcess() {
+    if (readyProcesses.empty()) {
+        return nullptr;
+    }
+    
+    // Lowest pass at every level, down to a process
+    int node = 0;
+    long long key = 0;
+    while (true) {
+        const auto& entry = *nodes[node].queue.begin();
+        nodes[node].virtualTime = entry.first;
+        key = entry.second;
+        if (key < 0) break;
+        node = static_cast<int>(key);
+    }
+    
+    nodes[node].queue.erase(nodes[node].queue.begin());
+    auto it = readyProcesses.find(static_cast<int>(-key));
+    auto process = it->second;
+    readyProcesses.erase(it);
+    
+    // Groups left without ready processes leave their parent's queue
+    for (int n = node; n >= 0; n = nodes[n].parent) {
+        if (--nodes[n].ready > 0 || nodes[n].parent < 0) continue;
+        nodes[nodes[n].parent].queue.erase({nodes[n].pass.value, n});
+    }
+    
+    return process;
+}
+
+bool ShareScheduler::shouldPreempt(std::shared_ptr<Process>) {
+    // Like stride, only the end of the quantum preempts
+    return false;
+}
+
+void ShareScheduler::updateWaitingTime(int timeElapsed) {
+    // Update waiting time for all ready processes (in place)
+    for (auto& entry : readyProcesses) {
+        entry.second->incrementWaitingTime(timeElapsed);
+    }
+}
+
+std::vector<std::shared_ptr<Process>> ShareScheduler::getReadyProcesses() const {
+    // Depth-first in queue order
+    std::vector<std::shared_ptr<Process>> ready;
+    std::function<void(int)> visit = [&](int node) {
+        for (const auto& entry : nodes[node].queue) {
+            if (entry.second < 0) {
+                ready.push_back(readyProcesses.at(static_cast<int>(-entry.second)));
+            } else {
+                visit(static_cast<int>(entry.second));
+            }
+        }
+    };
+    visit(0);
+    return ready;
+}
+
+void ShareScheduler::onCPUTime(std::shared_ptr<Process> process, int time) {
+    passes[process->getId()].advance(time, process->getTickets());
+    
+    // Groups still queued in their parent (other members ready) move to their new pass
+    for (int n = nodeOf(*process); n > 0; n = nodes[n].parent) {
+        Node& node = nodes[n];
+        long long previous = node.pass.value;
+        node.pass.advance(time, node.weight);
+        if (node.ready > 0) {
+            auto& queue = nodes[node.parent].queue;
+            queue.erase({previous, n});
+            queue.insert({node.pass.value, n});
+        }
+    }
+}
+
+void ShareScheduler::resetPolicyState() {
+    buildNodes();
+    readyProcesses.clear();
+    passes.clear();
+}
+
+std::vector<double> ShareScheduler::getPolicyState() const {
+    // Node count, (pass, remainder, virtual time) per node, then
+    // (pid, pass, remainder) in pid order
+    std::vector<double> state = {static_cast<double>(nodes.size())};
+    for (const auto& node : nodes) {
+        state.push_back(static_cast<double>(node.pass.value));
+        state.push_back(static_cast<double>(node.pass.remainder));
+        state.push_back(static_cast<double>(node.virtualTime));
+    }
+    
+    std::vector<std::pair<int, StridePass>> entries(passes.begin(), passes.end());
+    std::sort(entries.begin(), entries.end(),
+              [](const std::pair<int, StridePass>& a, const std::pair<int, StridePass>& b) { return a.first < b.first; });
+    for (const auto& entry : entries) {
+        state.push_back(entry.first);
+        state.push_back(static_cast<double>(entry.second.value));
+        state.push_back(static_cast<double>(entry.second.remainder));
+    }
+    return state;
+}
+
+bool ShareScheduler::setPolicyState(const std::vector<double>& state) {
+    // The ready processes were already added; rebuild the queues on the restored passes
+    if (state.empty() || static_cast<size_t>(state[0]) != nodes.size() ||
+        state.size() < 1 + 3 * nodes.size() || (state.size() - 1 - 3 * nodes.size()) % 3 != 0) {
+        return false;
+    }
+    
+    auto ready = getReadyProcesses();
+    buildNodes();
+    readyProcesses.clear();
+    passes.clear();
+    
+    size_t i = 1;
+    for (auto& node : nodes) {
+        node.pass.value = static_cast<long long>(state[i]);
+        node.pass.remainder = static_cast<long long>(state[i + 1]);
+        node.virtualTime = static_cast<long long>(state[i + 2]);
+        i += 3;
+    }
+    for (; i < state.size(); i += 3) {
+        StridePass& pass = passes[static_cast<int>(state[i])];
+        pass.value = static_cast<long long>(state[i + 1]);
+        pass.remainder = static_cast<long long>(state[i + 2]);
+    }
+    
+    for (const auto& process : ready) {
+        enqueue(process, false);
+    }
+    return true;
+}
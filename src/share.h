@@ -0,0 +1,67 @@
+#ifndef SHARE_H
+#define SHARE_H
+
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include "scheduler.h"
+#include "cgroup.h"
+#include "stride.h"
+
+// Hierarchical fair share scheduler (cgroup cpu.weight style)
+// Every group of the cgroup hierarchy and every process is an entity with a
+// pass value, as in stride scheduling (see StridePass): running t time units
+// advances a process by t * STRIDE1 / tickets and each of its groups by
+// t * STRIDE1 / weight. Each quantum, the scheduler walks down from the root
+// and at every level picks the ready child (subgroup or process) with the
+// lowest pass, so siblings share their parent's CPU time in proportion to
+// their weights. A pick and the pass updates of a charge cost O(depth log n).
+// Entities joining their parent's queue start no lower than its virtual time
+// (the pass of the child it picked last), so idle time builds up no credit.
+// Without a hierarchy all processes share the root by tickets.
+class ShareScheduler : public Scheduler {
+private:
+    // Node 0 is the root, node g + 1 the hierarchy group with index g
+    struct Node {
+        int parent;          // -1 for the root
+        int weight;
+        StridePass pass;     // Position of the group among its siblings
+        long long virtualTime;
+        int ready;           // Ready processes in the subtree
+        std::set<std::pair<long long, long long>> queue;   // (pass, child node, or -pid for a process)
+    };
+    
+    std::shared_ptr<const CgroupHierarchy> hierarchy;
+    std::vector<Node> nodes;
+    std::unordered_map<int, std::shared_ptr<Process>> readyProcesses;   // Process ID -> ready process
+    std::unordered_map<int, StridePass> passes;                         // Process ID -> pass
+    int timeQuantum;
+    
+    int nodeOf(const Process& process) const;
+    void buildNodes();
+    void enqueue(std::shared_ptr<Process> process, bool catchUp);
+    
+public:
+    ShareScheduler(int contextSwitchTime, int quantum);
+    
+    // Implementation of abstract methods
+    void addProcess(std::shared_ptr<Process> process) override;
+    std::shared_ptr<Process> getNextProcess() override;
+    bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
+    bool isPreemptive() const override { return true; }
+    void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    size_t getReadyQueueSize() const override { return readyProcesses.size(); }
+    int getTimeSlice() const override { return timeQuantum; }
+    
+    // Pass accounting
+    void onCPUTime(std::shared_ptr<Process> process, int time) override;
+    void resetPolicyState() override;
+    std::vector<double> getPolicyState() const override;
+    bool setPolicyState(const std::vector<double>& state) override;
+    
+    // Share specific methods
+    void setHierarchy(std::shared_ptr<const CgroupHierarchy> groups);
+};
+
+#endif // SHARE_H
@@ -4,31 +4,62 @@
 #include <algorithm>
 #include <limits>
 #include <sstream>
+#include <map>
 #include "fcfs.h"
 #include "sjf.h"
 #include "srtn.h"
 #include "rr.h"
+#include "psjf.h"
+#include "psrtn.h"
+#include "priority.h"
+#include "lottery.h"
+#include "stride.h"
+#include "adaptiverr.h"
+#include "gang.h"
+#include "share.h"
+#include "checkpoint.h"
+#include "jobs.h"
 
 Simulator::Simulator(int switchTime)
     : currentTime(0),
-      processSwitchTime(switchTime) {
+      switchInProgress(false),
+      runStartTime(0),
+      runningTag(0),
+      nextTag(0),
+      runSliceEnd(-1),
+      runEnd(0),
+      processedEvents(0),
+      dispatchDecisions(0),
+      processSwitchTime(switchTime),
+      switchCostModel(std::make_shared<FlatSwitchCost>()),
+      lastCpuPid(0),
+      cpuLastBusy(0),
+      blockedCount(0),
+      completedCount(0),
+      steadyState(nullptr),
+      stopRequested(false),
+      cgroupRun(nullptr),
+      dvfsRun(nullptr),
+      runSpeed(100),
+      memoryRun(nullptr),
+      output(&std::cout) {
     
     // Initialize schedulers
-    fcfsScheduler = std::make_shared<FCFSScheduler>(processSwitchTime);
-    sjfScheduler = std::make_shared<SJFScheduler>(processSwitchTime);
-    srtnScheduler = std::make_shared<SRTNScheduler>(processSwitchTime);
-    rr10Scheduler = std::make_shared<RRScheduler>(processSwitchTime, 10);
-    rr50Scheduler = std::make_shared<RRScheduler>(processSwitchTime, 50);
-    rr100Scheduler = std::make_shared<RRScheduler>(processSwitchTime, 100);
+    for (const auto& algorithm : algorithmNames()) {
+        schedulers.push_back(createScheduler(algorithm, processSwitchTime));
+    }
     
     // Default to FCFS
-    activeScheduler = fcfsScheduler;
+    activeScheduler = schedulers.front();
 }
 
 Simulator::~Simulator() {
     if (verboseOutput.is_open()) {
         verboseOutput.close();
     }
+    if (telemetryOutput.is_open()) {
+        telemetryOutput.close();
+    }
 }
 
 void Simulator::initialize(const std::vector<std::shared_ptr<Process>>& processList) {
@@ -44,18 +75,29 @@ void Simulator::setParams(const SimulationParams& simulationParams) {
     params = simulationParams;
     
     // Set active scheduler based on algorithm parameter
-    if (params.algorithm == "FCFS") {
-        activeScheduler = fcfsScheduler;
-    } else if (params.algorithm == "SJF") {
-        activeScheduler = sjfScheduler;
-    } else if (params.algorithm == "SRTN") {
-        activeScheduler = srtnScheduler;
-    } else if (params.algorithm == "RR10") {
-        activeScheduler = rr10Scheduler;
-    } else if (params.algorithm == "RR50") {
-        activeScheduler = rr50Scheduler;
-    } else if (params.algorithm == "RR100") {
-        activeScheduler = rr100Scheduler;
+    auto scheduler = schedulerFor(params.algorithm);
+    if (scheduler) {
+        activeScheduler = scheduler;
+    }
+    
+    // Context switch cost model (validated by the parser)
+    if (auto model = SwitchCostModel::create(params.switchCostSpec)) {
+        switchCostModel = model;
+    }
+    
+    // Exponential averaging parameters of the predictive schedulers
+    for (auto& candidate : schedulers) {
+        if (auto predictive = std::dynamic_pointer_cast<PredictiveScheduler>(candidate)) {
+            predictive->configurePredictor(params.predictionAlpha, params.initialPrediction);
+        } else if (auto priority = std::dynamic_pointer_cast<PriorityScheduler>(candidate)) {
+            priority->setAgingInterval(params.agingInterval);
+        } else if (auto lottery = std::dynamic_pointer_cast<LotteryScheduler>(candidate)) {
+            lottery->setSeed(params.seed);
+        } else if (auto adaptive = std::dynamic_pointer_cast<AdaptiveRRScheduler>(candidate)) {
+            adaptive->configure(params.targetLatency, params.minGranularity);
+        } else if (auto gang = std::dynamic_pointer_cast<GangScheduler>(candidate)) {
+            gang->setGangSlot(params.gangSlot);
+        }
     }
     
     // Open verbose output file if in verbose mode
@@ -68,17 +110,163 @@ void Simulator::setParams(const SimulationParams& simulationParams) {
         }
         verboseOutput.open(filename);
     }
+    
+    // Open the telemetry CSV if windowed telemetry is on
+    if (params.telemetryWindow > 0) {
+        telemetryOutput.open(params.telemetryFile);
+        if (!telemetryOutput) {
+            std::cerr << "Error: Cannot write telemetry file " << params.telemetryFile << std::endl;
+        } else {
+            Telemetry::writeHeader(telemetryOutput);
+        }
+    }
+    
+    // Frequency governor and power model (validated by the parser and by simulateProcesses)
+    dvfsModel.reset();
+    if (!params.dvfsSpec.empty()) {
+        dvfsModel = DvfsModel::create(params.dvfsSpec);
+    }
+    
+    // Structured per-process results (format validated by the parser)
+    ResultWriter::Format resultsFormat;
+    if (!params.resultsFile.empty() && ResultWriter::formatFor(params.resultsFile, resultsFormat)) {
+        resultWriter.reset(new ResultWriter(params.resultsFile, resultsFormat));
+    }
+}
+
+std::shared_ptr<Scheduler> Simulator::schedulerFor(const std::string& algorithm) const {
+    const auto& names = algorithmNames();
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == algorithm) {
+            return schedulers[i];
+        }
+    }
+    return nullptr;
+}
+
+const std::vector<std::string>& Simulator::algorithmNames() {
+    static const std::vector<std::string> names = {
+        "FCFS", "SJF", "SRTN", "PSJF", "PSRTN", "PRIO", "LOTTERY", "STRIDE", "RR10", "RR50", "RR100", "RRA",
+        "GANG", "SHARE"
+    };
+    return names;
+}
+
+std::string Simulator::algorithmFor(std::shared_ptr<Scheduler> scheduler) const {
+    for (size_t i = 0; i < schedulers.size(); i++) {
+        if (schedulers[i] == scheduler) {
+            return algorithmNames()[i];
+        }
+    }
+    return params.algorithm;
+}
+
+void Simulator::startTelemetry(std::shared_ptr<Scheduler> scheduler) {
+    // Ring of 1024 windows, drained to the CSV whenever it fills up
+    const size_t TELEMETRY_RING_SIZE = 1024;
+    
+    telemetry.reset();
+    if (params.telemetryWindow > 0 && telemetryOutput.is_open()) {
+        telemetry.reset(new Telemetry(params.telemetryWindow, TELEMETRY_RING_SIZE, algorithmFor(scheduler),
+                                      telemetryOutput, currentTime));
+    }
+}
+
+std::shared_ptr<Scheduler> Simulator::createScheduler(const std::string& algorithm, int switchTime) {
+    if (algorithm == "FCFS") {
+        return std::make_shared<FCFSScheduler>(switchTime);
+    } else if (algorithm == "SJF") {
+        return std::make_shared<SJFScheduler>(switchTime);
+    } else if (algorithm == "SRTN") {
+        return std::make_shared<SRTNScheduler>(switchTime);
+    } else if (algorithm == "PSJF") {
+        return std::make_shared<PSJFScheduler>(switchTime);
+    } else if (algorithm == "PSRTN") {
+        return std::make_shared<PSRTNScheduler>(switchTime);
+    } else if (algorithm == "PRIO") {
+        return std::make_shared<PriorityScheduler>(switchTime, DEFAULT_AGING_INTERVAL);
+    } else if (algorithm == "LOTTERY") {
+        return std::make_shared<LotteryScheduler>(switchTime, 10);
+    } else if (algorithm == "STRIDE") {
+        return std::make_shared<StrideScheduler>(switchTime, 10);
+    } else if (algorithm == "RRA") {
+        return std::make_shared<AdaptiveRRScheduler>(switchTime, DEFAULT_TARGET_LATENCY, DEFAULT_MIN_GRANULARITY);
+    } else if (algorithm == "SHARE") {
+        return std::make_shared<ShareScheduler>(switchTime, 10);
+    } else if (algorithm == "GANG") {
+        return std::make_shared<GangScheduler>(switchTime, DEFAULT_GANG_SLOT);
+    } else if (algorithm == "RR10") {
+        return std::make_shared<RRScheduler>(switchTime, 10);
+    } else if (algorithm == "RR50") {
+        return std::make_shared<RRScheduler>(switchTime, 50);
+    } else if (algorithm == "RR100") {
+        return std::make_shared<RRScheduler>(switchTime, 100);
+    }
+    return nullptr;
+}
+
+void Simulator::outputSteadyState(const SteadyStateRun& run) const {
+    const SteadyStateDetector& detector = run.detector;
+    
+    *output << "Steady State (MSER-5 warm-up, target +/-" << std::fixed << std::setprecision(1)
+              << 100.0 * detector.getPrecision() << "%):\n"
+              << "  Warm-up discarded: " << detector.getTruncation() << " of " << detector.getObservations()
+              << " completions (until t=" << detector.getWarmupEndTime() << ")\n";
+    
+    *output << std::setprecision(2);
+    if (detector.getMean() > 0.0) {
+        *output << "  Mean Turnaround: " << detector.getMean() << " +/- " << detector.getHalfWidth()
+                  << " (95% CI, " << detector.getBatches() << " batch means)\n"
+                  << "  Mean Waiting: " << detector.getMeanWaiting() << "\n";
+    } else {
+        *output << "  Too few completions after the warm-up for an interval\n";
+    }
+    
+    *output << "  Simulated: " << run.completedProcesses << " of " << run.totalProcesses << " processes, "
+              << (run.totalWork > 0 ? 100.0 * run.simulatedWork / run.totalWork : 0.0) << "% of the CPU demand ("
+              << (run.stoppedEarly ? "stopped early, precision reached" :
+                  detector.hasConverged() ? "ran to completion" : "ran to completion, precision not reached")
+              << ")\n\n";
+}
+
+RunSummary Simulator::summarize() const {
+    RunSummary summary;
+    summary.algorithm = params.algorithm;
+    summary.name = activeScheduler->getName();
+    summary.processes = static_cast<int>(processes.size());
+    summary.totalTime = activeScheduler->getTotalTime();
+    summary.cpuUtilization = activeScheduler->getCpuUtilization();
+    summary.contextSwitches = activeScheduler->getContextSwitchCount();
+    
+    double totalTurnaround = 0.0;
+    double totalWaiting = 0.0;
+    for (const auto& process : processes) {
+        totalTurnaround += process->getTurnaroundTime();
+        totalWaiting += process->getWaitingTime();
+    }
+    double count = processes.empty() ? 1.0 : static_cast<double>(processes.size());
+    summary.avgTurnaround = totalTurnaround / count;
+    summary.avgWaiting = totalWaiting / count;
+    
+    // Steady-state estimates replace the whole-run averages when available
+    auto steadyRun = steadyStateRuns.find(activeScheduler.get());
+    if (steadyRun != steadyStateRuns.end() && steadyRun->second.detector.getMean() > 0.0) {
+        summary.avgTurnaround = steadyRun->second.detector.getMean();
+        summary.avgWaiting = steadyRun->second.detector.getMeanWaiting();
+    }
+    
+    return summary;
 }
 
 void Simulator::run() {
+    processedEvents = 0;
+    dispatchDecisions = 0;
+    
     if (params.algorithm == "ALL") {
         // Run each scheduler separately
-        runScheduler(fcfsScheduler);
-        runScheduler(sjfScheduler);
-        runScheduler(srtnScheduler);
-        runScheduler(rr10Scheduler);
-        runScheduler(rr50Scheduler);
-        runScheduler(rr100Scheduler);
+        for (auto& scheduler : schedulers) {
+            runScheduler(scheduler);
+        }
     } else {
         // Run only the active scheduler
         runScheduler(activeScheduler);
@@ -86,78 +274,245 @@ void Simulator::run() {
 }
 
 void Simulator::runScheduler(std::shared_ptr<Scheduler> scheduler) {
+    beginRun(scheduler);
+    advance(scheduler, -1);
+    finishRun(scheduler);
+}
+
+void Simulator::start() {
+    processedEvents = 0;
+    dispatchDecisions = 0;
+    beginRun(activeScheduler);
+}
+
+void Simulator::runUntil(int time) {
+    advance(activeScheduler, time);
+}
+
+void Simulator::finish() {
+    advance(activeScheduler, -1);
+    finishRun(activeScheduler);
+}
+
+void Simulator::addArrival(std::shared_ptr<Process> process, bool track) {
+    process->reset();
+    Event arrivalEvent(EventType::PROCESS_ARRIVAL, process->getArrivalTime(), process);
+    eventQueue.push(arrivalEvent);
+    
+    if (track) {
+        processes.push_back(process);
+        activeScheduler->addToAllProcesses(process);
+    }
+}
+
+void Simulator::beginRun(std::shared_ptr<Scheduler> scheduler) {
     // Reset simulation state
     currentTime = 0;
     scheduler->setTotalTime(0);
     scheduler->clearCurrentProcess();
+    scheduler->resetPolicyState();
+    switchInProgress = false;
+    lastCpuPid = 0;
+    cpuLastBusy = 0;
+    lastRunEnd.clear();
+    blockedCount = 0;
+    completedCount = 0;
+    startTelemetry(scheduler);
     
-    // Clear event queue
-    while (!eventQueue.empty()) {
-        eventQueue.pop();
+    stopRequested = false;
+    steadyState = nullptr;
+    if (params.steadyStatePrecision > 0.0) {
+        steadyStateRuns[scheduler.get()] = SteadyStateRun{SteadyStateDetector(params.steadyStatePrecision)};
+        steadyState = &steadyStateRuns[scheduler.get()];
     }
+    runStartTime = 0;
+    runningTag = 0;
+    nextTag = 0;
+    readiedInBatch.clear();
     
-    // Reset all processes and add initial events
+    cgroupRun = nullptr;
+    throttledProcesses.clear();
+    if (cgroups && !cgroups->empty()) {
+        cgroupRuns[scheduler.get()] = CgroupAccounting(cgroups);
+        cgroupRun = &cgroupRuns[scheduler.get()];
+    }
+    
+    dvfsRun = nullptr;
+    if (dvfsModel) {
+        dvfsRuns[scheduler.get()] = DvfsAccounting(dvfsModel, currentTime);
+        dvfsRun = &dvfsRuns[scheduler.get()];
+    }
+    
+    memoryRun = nullptr;
+    if (memoryConfig.isDefined()) {
+        memoryRuns[scheduler.get()] = MemoryAccounting(memoryConfig);
+        memoryRun = &memoryRuns[scheduler.get()];
+    }
+    
+    // Clear event queue
+    eventQueue.clear();
+    
+    // Reset all processes and add initial events; dependent processes
+    // arrive when their last predecessor terminates
     for (auto& process : processes) {
-        process->setState(ProcessState::NEW);
-        Event arrivalEvent(EventType::PROCESS_ARRIVAL, process->getArrivalTime(), process);
-        eventQueue.push(arrivalEvent);
+        process->reset();
+    }
+    buildDependencies();
+    for (auto& process : processes) {
+        if (!pendingPredecessors.count(process->getId())) {
+            Event arrivalEvent(EventType::PROCESS_ARRIVAL, process->getArrivalTime(), process);
+            eventQueue.push(arrivalEvent);
+        }
         scheduler->addToAllProcesses(process);
     }
+}
+
+void Simulator::buildDependencies() {
+    dependents.clear();
+    pendingPredecessors.clear();
+    
+    std::unordered_map<int, const Process*> byId;
+    for (const auto& process : processes) {
+        byId[process->getId()] = process.get();
+    }
     
-    // Main event loop
-    while (!eventQueue.empty()) {
-        Event event = eventQueue.top();
-        eventQueue.pop();
+    // Predecessors that already terminated (in a restored run) no longer hold anybody back
+    for (const auto& process : processes) {
+        for (int pid : process->getPredecessors()) {
+            auto predecessor = byId.find(pid);
+            if (predecessor != byId.end() && predecessor->second->isCompleted()) continue;
+            dependents[pid].push_back(process);
+            pendingPredecessors[process->getId()]++;
+        }
+    }
+}
+
+void Simulator::releaseDependents(const Process& process) {
+    auto it = dependents.find(process.getId());
+    if (it == dependents.end()) return;
+    
+    for (auto& dependent : it->second) {
+        auto pending = pendingPredecessors.find(dependent->getId());
+        if (pending == pendingPredecessors.end() || --pending->second > 0) continue;
+        pendingPredecessors.erase(pending);
         
-        // Update time and statistics
-        int timeElapsed = event.getTime() - currentTime;
-        if (timeElapsed > 0) {
-            scheduler->updateWaitingTime(timeElapsed);
-            
-            if (scheduler->hasCpuProcess()) {
-                scheduler->incrementCpuBusyTime(timeElapsed);
-                
-                // For Round Robin, update time slice
-                if (auto rrScheduler = std::dynamic_pointer_cast<RRScheduler>(scheduler)) {
-                    rrScheduler->decrementTimeSlice(timeElapsed);
-                }
-            }
+        // Released now, or at its own arrival time if that is still ahead
+        dependent->setReleaseTime(std::max(dependent->getArrivalTime(), currentTime));
+        Event arrivalEvent(EventType::PROCESS_ARRIVAL, dependent->getReleaseTime(), dependent);
+        eventQueue.push(arrivalEvent);
+    }
+}
+
+const DvfsAccounting* Simulator::getDvfsAccounting() const {
+    auto it = dvfsRuns.find(activeScheduler.get());
+    return it != dvfsRuns.end() ? &it->second : nullptr;
+}
+
+void Simulator::setCgroups(std::shared_ptr<const CgroupHierarchy> hierarchy) {
+    cgroups = hierarchy;
+    for (auto& scheduler : schedulers) {
+        if (auto share = std::dynamic_pointer_cast<ShareScheduler>(scheduler)) {
+            share->setHierarchy(hierarchy);
         }
+    }
+}
+
+bool Simulator::holdIfThrottled(std::shared_ptr<Process> process) {
+    if (!cgroupRun) return false;
+    
+    // Held back under the highest throttled group until that one is refilled
+    int group = cgroupRun->throttledAncestor(cgroupOf(*process));
+    if (group < 0) return false;
+    
+    process->setState(ProcessState::READY);
+    throttledProcesses[group].push_back(process);
+    return true;
+}
+
+std::shared_ptr<Process> Simulator::nextRunnableProcess(std::shared_ptr<Scheduler> scheduler) {
+    // Ready processes whose group was throttled after they queued are held back when reached
+    auto process = scheduler->getNextProcess();
+    while (process && holdIfThrottled(process)) {
+        process = scheduler->getNextProcess();
+    }
+    return process;
+}
+
+void Simulator::advance(std::shared_ptr<Scheduler> scheduler, int stopTime) {
+    // Main event loop: every iteration handles one batch of events sharing a
+    // timestamp (or a single event when batching is disabled) and then takes
+    // a single dispatch decision. A non-negative stopTime ends the loop after
+    // the last batch at or before stopTime and moves the clock to stopTime.
+    while (!eventQueue.empty() && !stopRequested && (stopTime < 0 || eventQueue.top().getTime() <= stopTime)) {
+        advanceClock(scheduler, eventQueue.top().getTime());
         
-        currentTime = event.getTime();
+        // Drain the batch in (type priority, insertion) order, see event.h
+        do {
+            Event event = eventQueue.top();
+            eventQueue.pop();
+            processEvent(event, scheduler);
+        } while (params.batchEvents && !eventQueue.empty() && eventQueue.top().getTime() == currentTime);
         
-        // Process the event
-        switch (event.getType()) {
-            case EventType::PROCESS_ARRIVAL:
-                processArrival(event, scheduler);
-                break;
-            case EventType::CPU_BURST_COMPLETION:
-                processCPUBurstCompletion(event, scheduler);
-                break;
-            case EventType::IO_COMPLETION:
-                processIOCompletion(event, scheduler);
-                break;
-            case EventType::TIMER_INTERRUPT:
-                processTimerInterrupt(event, scheduler);
-                break;
-            case EventType::CONTEXT_SWITCH_COMPLETE:
-                processContextSwitchComplete(event, scheduler);
-                break;
+        dispatch(scheduler);
+    }
+    
+    if (stopTime > currentTime && !eventQueue.empty() && !stopRequested) {
+        advanceClock(scheduler, stopTime);
+    }
+}
+
+void Simulator::advanceClock(std::shared_ptr<Scheduler> scheduler, int newTime) {
+    // Update time and statistics
+    int timeElapsed = newTime - currentTime;
+    if (timeElapsed > 0 && telemetry) {
+        telemetry->advance(currentTime, newTime, scheduler->hasCpuProcess(),
+                           scheduler->getReadyQueueSize(), blockedCount);
+    }
+    if (timeElapsed > 0) {
+        scheduler->updateWaitingTime(timeElapsed);
+        for (auto& entry : throttledProcesses) {
+            for (auto& process : entry.second) {
+                process->incrementWaitingTime(timeElapsed);
+            }
         }
         
-        // Check for timer interrupt in Round Robin
-        if (auto rrScheduler = std::dynamic_pointer_cast<RRScheduler>(scheduler)) {
-            if (rrScheduler->hasCpuProcess() && rrScheduler->isTimeSliceExpired()) {
-                Event timerEvent(EventType::TIMER_INTERRUPT, currentTime, 
-                               rrScheduler->getCurrentProcess());
-                eventQueue.push(timerEvent);
-            }
+        if (scheduler->hasCpuProcess()) {
+            scheduler->incrementCpuBusyTime(timeElapsed);
+        }
+        if (dvfsRun) {
+            dvfsRun->advance(currentTime, newTime, scheduler->hasCpuProcess() || switchInProgress);
         }
     }
     
+    currentTime = newTime;
+}
+
+void Simulator::finishRun(std::shared_ptr<Scheduler> scheduler) {
     // Set final statistics
     scheduler->setTotalTime(currentTime);
     
+    // How much of the workload the steady-state run actually simulated
+    if (steadyState) {
+        steadyState->stoppedEarly = stopRequested;
+        steadyState->totalProcesses = static_cast<int>(scheduler->getAllProcesses().size());
+        for (const auto& process : scheduler->getAllProcesses()) {
+            if (process->isCompleted()) {
+                steadyState->completedProcesses++;
+            }
+            steadyState->totalWork += process->getServiceTime();
+            steadyState->simulatedWork += process->getServiceTime() - process->getRemainingCPUTime();
+        }
+        steadyState->detector.evaluate();
+        steadyState = nullptr;
+    }
+    
+    if (cgroupRun) {
+        cgroupRun->finish(currentTime);
+        cgroupRun = nullptr;
+    }
+    dvfsRun = nullptr;
+    memoryRun = nullptr;
+    
     // Calculate CPU utilization
     if (currentTime > 0) {
         double utilization = (static_cast<double>(scheduler->getCpuBusyTime()) / currentTime) * 100.0;
@@ -171,94 +526,553 @@ void Simulator::runScheduler(std::shared_ptr<Scheduler> scheduler) {
             process->setState(ProcessState::TERMINATED);
         }
     }
+    
+    if (telemetry) {
+        telemetry->finish(currentTime);
+        telemetry.reset();
+    }
+    
+    if (output) {
+        jobRuns[scheduler.get()] = computeJobStats(scheduler->getAllProcesses());
+    }
+    
+    // Rows are copied now, before the next run resets the processes, and written while it runs
+    if (resultWriter || params.starvationLimit >= 0 || (output && params.detailedMode)) {
+        ProcessResultTable table;
+        table.capture(algorithmFor(scheduler), scheduler->getAllProcesses());
+        if (params.starvationLimit >= 0) {
+            analyticsRuns[scheduler.get()] = analyzeRun(table, params.starvationLimit);
+        }
+        if (output && params.detailedMode) {
+            detailRuns[scheduler.get()] = table;
+        }
+        if (resultWriter) {
+            resultWriter->submit(std::move(table));
+        }
+    }
+}
+
+std::shared_ptr<const SimulationSnapshot> Simulator::checkpoint() const {
+    auto snapshot = std::make_shared<SimulationSnapshot>();
+    
+    snapshot->algorithm = params.algorithm;
+    snapshot->currentTime = currentTime;
+    snapshot->processSwitchTime = processSwitchTime;
+    snapshot->switchCostSpec = params.switchCostSpec;
+    snapshot->switchInProgress = switchInProgress;
+    snapshot->runStartTime = runStartTime;
+    snapshot->runningTag = runningTag;
+    snapshot->nextTag = nextTag;
+    snapshot->processedEvents = processedEvents;
+    snapshot->dispatchDecisions = dispatchDecisions;
+    
+    for (const auto& event : eventQueue.getEvents()) {
+        int pid = event.getProcess() ? event.getProcess()->getId() : 0;
+        snapshot->events.push_back({event.getType(), event.getTime(), pid, event.getTag(), event.getSequence()});
+    }
+    snapshot->nextSequence = eventQueue.getNextSequence();
+    
+    snapshot->cpuBusyTime = activeScheduler->getCpuBusyTime();
+    snapshot->contextSwitchCount = activeScheduler->getContextSwitchCount();
+    auto current = activeScheduler->getCurrentProcess();
+    snapshot->currentPid = current ? current->getId() : 0;
+    for (const auto& process : activeScheduler->getReadyProcesses()) {
+        snapshot->readyPids.push_back(process->getId());
+    }
+    if (auto rrScheduler = std::dynamic_pointer_cast<RRScheduler>(activeScheduler)) {
+        snapshot->timeQuantum = rrScheduler->getTimeQuantum();
+        snapshot->currentTimeSlice = rrScheduler->getCurrentTimeSlice();
+    }
+    snapshot->policyState = activeScheduler->getPolicyState();
+    snapshot->switchBreakdown = activeScheduler->getSwitchBreakdown();
+    snapshot->lastCpuPid = lastCpuPid;
+    snapshot->cpuLastBusy = cpuLastBusy;
+    snapshot->lastRunEnd.assign(lastRunEnd.begin(), lastRunEnd.end());
+    std::sort(snapshot->lastRunEnd.begin(), snapshot->lastRunEnd.end());
+    
+    // O(1) per process: the copies share their burst lists
+    for (const auto& process : processes) {
+        snapshot->processes.push_back(std::make_shared<const Process>(*process));
+    }
+    
+    snapshot->cgroups = cgroups;
+    if (cgroupRun) {
+        snapshot->cgroupState = cgroupRun->getState();
+        
+        // Group order, then the order the processes were held back in
+        std::map<int, const std::vector<std::shared_ptr<Process>>*> held;
+        for (const auto& entry : throttledProcesses) {
+            held[entry.first] = &entry.second;
+        }
+        for (const auto& entry : held) {
+            for (const auto& process : *entry.second) {
+                snapshot->throttledPids.push_back({entry.first, process->getId()});
+            }
+        }
+    }
+    
+    return snapshot;
+}
+
+bool Simulator::restore(const SimulationSnapshot& snapshot) {
+    auto scheduler = schedulerFor(snapshot.algorithm);
+    if (!scheduler) {
+        std::cerr << "Error: Checkpoint uses unknown algorithm " << snapshot.algorithm << std::endl;
+        return false;
+    }
+    params.algorithm = snapshot.algorithm;
+    activeScheduler = scheduler;
+    setSwitchTime(snapshot.processSwitchTime);
+    
+    auto model = SwitchCostModel::create(snapshot.switchCostSpec);
+    if (!model) {
+        return false;
+    }
+    params.switchCostSpec = snapshot.switchCostSpec;
+    switchCostModel = model;
+    
+    std::map<int, std::shared_ptr<Process>> byId;
+    processes.clear();
+    for (const auto& process : snapshot.processes) {
+        auto copy = std::make_shared<Process>(*process);
+        processes.push_back(copy);
+        byId[copy->getId()] = copy;
+        scheduler->addToAllProcesses(copy);
+    }
+    
+    auto lookup = [&byId](int pid) -> std::shared_ptr<Process> {
+        auto it = byId.find(pid);
+        return it != byId.end() ? it->second : nullptr;
+    };
+    
+    buildDependencies();
+    setCgroups(snapshot.cgroups);
+    
+    scheduler->clearCurrentProcess();
+    scheduler->restoreCounters(snapshot.cpuBusyTime, snapshot.contextSwitchCount);
+    for (int pid : snapshot.readyPids) {
+        auto process = lookup(pid);
+        if (!process) {
+            std::cerr << "Error: Checkpoint references unknown process " << pid << std::endl;
+            return false;
+        }
+        scheduler->addProcess(process);
+    }
+    if (snapshot.currentPid != 0) {
+        scheduler->setCurrentProcess(lookup(snapshot.currentPid));
+    }
+    if (auto rrScheduler = std::dynamic_pointer_cast<RRScheduler>(scheduler)) {
+        rrScheduler->setTimeQuantum(snapshot.timeQuantum);
+        rrScheduler->setCurrentTimeSlice(snapshot.currentTimeSlice);
+    }
+    if (!scheduler->restoreSwitchBreakdown(snapshot.switchBreakdown)) {
+        std::cerr << "Error: Checkpoint has an invalid switch overhead breakdown" << std::endl;
+        return false;
+    }
+    lastCpuPid = snapshot.lastCpuPid;
+    cpuLastBusy = snapshot.cpuLastBusy;
+    lastRunEnd.clear();
+    lastRunEnd.insert(snapshot.lastRunEnd.begin(), snapshot.lastRunEnd.end());
+    if (!scheduler->setPolicyState(snapshot.policyState)) {
+        std::cerr << "Error: Checkpoint has invalid " << snapshot.algorithm << " scheduler state" << std::endl;
+        return false;
+    }
+    
+    cgroupRun = nullptr;
+    throttledProcesses.clear();
+    if (cgroups && !cgroups->empty()) {
+        cgroupRuns[scheduler.get()] = CgroupAccounting(cgroups);
+        cgroupRun = &cgroupRuns[scheduler.get()];
+        if (!cgroupRun->setState(snapshot.cgroupState)) {
+            std::cerr << "Error: Checkpoint has invalid cgroup accounting" << std::endl;
+            return false;
+        }
+        for (const auto& entry : snapshot.throttledPids) {
+            auto process = lookup(entry.second);
+            if (!process || entry.first < 0 || entry.first >= static_cast<int>(cgroups->size())) {
+                std::cerr << "Error: Checkpoint references unknown process " << entry.second << std::endl;
+                return false;
+            }
+            throttledProcesses[entry.first].push_back(process);
+        }
+    }
+    
+    eventQueue.clear();
+    for (const auto& record : snapshot.events) {
+        auto process = lookup(record.pid);
+        if (record.pid != 0 && !process) {
+            std::cerr << "Error: Checkpoint references unknown process " << record.pid << std::endl;
+            return false;
+        }
+        eventQueue.pushRestored(Event(record.type, record.time, process, record.tag), record.sequence);
+    }
+    eventQueue.setNextSequence(snapshot.nextSequence);
+    
+    currentTime = snapshot.currentTime;
+    switchInProgress = snapshot.switchInProgress;
+    runStartTime = snapshot.runStartTime;
+    runningTag = snapshot.runningTag;
+    nextTag = snapshot.nextTag;
+    processedEvents = snapshot.processedEvents;
+    dispatchDecisions = snapshot.dispatchDecisions;
+    
+    // Which processes became ready during an unfinished switch is not
+    // recorded; all ready ones are checked when it completes (those that were
+    // already waiting when it began lost to the incoming process)
+    readiedInBatch.clear();
+    if (switchInProgress) {
+        readiedInBatch = scheduler->getReadyProcesses();
+    }
+    
+    // Telemetry of a resumed run starts at the checkpoint time
+    blockedCount = 0;
+    for (const auto& process : processes) {
+        if (process->getState() == ProcessState::BLOCKED) {
+            blockedCount++;
+        }
+    }
+    startTelemetry(scheduler);
+    
+    return true;
+}
+
+void Simulator::setSwitchTime(int switchTime) {
+    // Applies to switches started from now on
+    processSwitchTime = switchTime;
+    for (auto& scheduler : schedulers) {
+        scheduler->setContextSwitchTime(switchTime);
+    }
+}
+
+bool Simulator::setTimeQuantum(int quantum) {
+    auto rrScheduler = std::dynamic_pointer_cast<RRScheduler>(activeScheduler);
+    if (!rrScheduler) {
+        return false;
+    }
+    rrScheduler->setTimeQuantum(quantum);
+    return true;
+}
+
+void Simulator::processEvent(const Event& event, std::shared_ptr<Scheduler> scheduler) {
+    processedEvents++;
+    
+    switch (event.getType()) {
+        case EventType::PROCESS_ARRIVAL:
+            processArrival(event, scheduler);
+            break;
+        case EventType::CPU_BURST_COMPLETION:
+            processCPUBurstCompletion(event, scheduler);
+            break;
+        case EventType::IO_COMPLETION:
+            processIOCompletion(event, scheduler);
+            break;
+        case EventType::TIMER_INTERRUPT:
+            processTimerInterrupt(event, scheduler);
+            break;
+        case EventType::CONTEXT_SWITCH_COMPLETE:
+            processContextSwitchComplete(event, scheduler);
+            break;
+        case EventType::CGROUP_THROTTLE:
+            processCgroupThrottle(event, scheduler);
+            break;
+        case EventType::CGROUP_UNTHROTTLE:
+            processCgroupUnthrottle(event, scheduler);
+            break;
+        case EventType::FREQUENCY_CHANGE:
+            processFrequencyChange(event, scheduler);
+            break;
+        case EventType::SWAP_OUT_COMPLETE:
+            processSwapOutComplete(event, scheduler);
+            break;
+        case EventType::SWAP_IN_COMPLETE:
+            processSwapInComplete(event, scheduler);
+            break;
+    }
+}
+
+void Simulator::dispatch(std::shared_ptr<Scheduler> scheduler) {
+    dispatchDecisions++;
+    bool waitingForSwitch = switchInProgress;
+    
+    // A preemptive scheduler compares the running process against everything
+    // that became ready during the batch, but switches at most once. While a
+    // context switch is in progress there is nothing to compare against yet:
+    // the processes are kept and checked in the batch where the switch
+    // completes, against the process it brought in.
+    if (scheduler->hasCpuProcess() && scheduler->isPreemptive()) {
+        chargeRunningProcess(scheduler);
+        for (auto& process : readiedInBatch) {
+            if (process->getState() == ProcessState::READY && checkPreemption(process, scheduler)) {
+                break;
+            }
+        }
+    }
+    if (!waitingForSwitch) {
+        readiedInBatch.clear();
+    }
+    
+    scheduleNextEvent(scheduler);
+}
+
+void Simulator::chargeRunningProcess(std::shared_ptr<Scheduler> scheduler) {
+    auto process = scheduler->getCurrentProcess();
+    if (!process || currentTime <= runStartTime) return;
+    
+    // Below the top frequency the burst progresses by less than the time spent
+    int elapsed = currentTime - runStartTime;
+    process->updateRemainingTime(dvfsRun ? dvfsRun->workDone(process->getId(), elapsed, runSpeed) : elapsed);
+    scheduler->onCPUTime(process, elapsed);
+    if (cgroupRun) {
+        cgroupRun->charge(cgroupOf(*process), runStartTime, currentTime);
+    }
+    runStartTime = currentTime;
+    if (dvfsRun) {
+        runSpeed = dvfsRun->getSpeed();
+    }
+    
+    lastCpuPid = process->getId();
+    cpuLastBusy = currentTime;
+    lastRunEnd[lastCpuPid] = currentTime;
 }
 
 void Simulator::processArrival(const Event& event, std::shared_ptr<Scheduler> scheduler) {
     auto process = event.getProcess();
     
+    // Without room in memory it waits for admission instead
+    if (memoryRun && !memoryRun->arrive(process, currentTime)) {
+        rebalanceMemory(scheduler);
+        return;
+    }
+    
     if (params.verboseMode) {
         logStateTransition(process, process->getState(), ProcessState::READY);
     }
     
+    if (holdIfThrottled(process)) return;
     scheduler->addProcess(process);
-    
-    if (!scheduler->hasCpuProcess()) {
-        scheduleNextEvent(scheduler);
-    } else if (scheduler->isPreemptive()) {
-        checkPreemption(process, scheduler);
-    }
+    readiedInBatch.push_back(process);
 }
 
 void Simulator::processCPUBurstCompletion(const Event& event, std::shared_ptr<Scheduler> scheduler) {
     auto process = event.getProcess();
+    
+    // Ignore completions of dispatches that were preempted
+    if (event.getTag() != runningTag || scheduler->getCurrentProcess() != process) return;
+    
+    chargeRunningProcess(scheduler);
+    scheduler->onCPUBurstComplete(process, process->getCurrentBurst().duration);
     process->advanceBurst();
+    scheduler->clearCurrentProcess();
+    runningTag = 0;
     
-    if (process->getCurrentBurstIndex() >= process->getTotalBursts()) {
+    if (!process->hasCurrentBurst()) {
         if (params.verboseMode) {
             logStateTransition(process, ProcessState::RUNNING, ProcessState::TERMINATED);
         }
         
         process->setState(ProcessState::TERMINATED);
         process->setFinishTime(currentTime);
-        scheduler->clearCurrentProcess();
-        scheduleNextEvent(scheduler);
+        completedCount++;
+        if (memoryRun) {
+            memoryRun->release(*process);
+            rebalanceMemory(scheduler);
+        }
+        if (telemetry) {
+            telemetry->recordCompletion();
+        }
+        
+        // Stop once the steady-state estimate is precise enough, checked every few completions
+        const size_t STEADY_STATE_CHECK_INTERVAL = 50;
+        if (steadyState) {
+            steadyState->detector.add(process->getTurnaroundTime(), process->getWaitingTime(), currentTime);
+            if (steadyState->detector.getObservations() % STEADY_STATE_CHECK_INTERVAL == 0 &&
+                steadyState->detector.evaluate()) {
+                stopRequested = true;
+            }
+        }
+        
+        releaseDependents(*process);
+        
+        if (jobSource) {
+            if (auto nextJob = jobSource->onCompletion(*process, currentTime)) {
+                addArrival(nextJob, false);
+            }
+        }
     } else if (process->getCurrentBurst().type == BurstType::IO) {
         if (params.verboseMode) {
             logStateTransition(process, ProcessState::RUNNING, ProcessState::BLOCKED);
         }
         
         process->setState(ProcessState::BLOCKED);
+        blockedCount++;
         int ioCompletionTime = currentTime + process->getCurrentBurst().duration;
         Event ioCompletionEvent(EventType::IO_COMPLETION, ioCompletionTime, process);
         eventQueue.push(ioCompletionEvent);
         
-        scheduler->clearCurrentProcess();
-        scheduleNextEvent(scheduler);
+        // A blocked process may be swapped out for those waiting for memory
+        if (memoryRun) {
+            memoryRun->blockedOnIO(process, ioCompletionTime);
+            if (memoryRun->hasWaiting()) {
+                rebalanceMemory(scheduler);
+            }
+        }
     }
 }
 
 void Simulator::processIOCompletion(const Event& event, std::shared_ptr<Scheduler> scheduler) {
     auto process = event.getProcess();
     process->advanceBurst();
+    blockedCount--;
+    
+    // Swapped out during the I/O: ready once swapped back in
+    if (memoryRun && !memoryRun->ioCompleted(process, currentTime)) {
+        rebalanceMemory(scheduler);
+        return;
+    }
     
     if (params.verboseMode) {
         logStateTransition(process, ProcessState::BLOCKED, ProcessState::READY);
     }
     
+    if (holdIfThrottled(process)) return;
     scheduler->addProcess(process);
+    readiedInBatch.push_back(process);
+}
+
+void Simulator::processTimerInterrupt(const Event& event, std::shared_ptr<Scheduler> scheduler) {
+    auto process = event.getProcess();
+    if (event.getTag() != runningTag || scheduler->getCurrentProcess() != process) return;
+    
+    chargeRunningProcess(scheduler);
+    
+    // Nobody else is waiting: keep running with a fresh quantum, no switch needed
+    if (scheduler->getReadyQueueSize() == 0) {
+        scheduler->renewTimeSlice();
+        scheduleProcess(process, scheduler);
+        return;
+    }
     
-    if (!scheduler->hasCpuProcess()) {
-        scheduleNextEvent(scheduler);
-    } else if (scheduler->isPreemptive()) {
-        checkPreemption(process, scheduler);
+    if (params.verboseMode) {
+        logStateTransition(process, ProcessState::RUNNING, ProcessState::READY);
     }
+    
+    scheduler->clearCurrentProcess();
+    runningTag = 0;
+    scheduler->addProcess(process);
 }
 
-void Simulator::processTimerInterrupt(const Event& event, std::shared_ptr<Scheduler> scheduler) {
-    auto rrScheduler = std::dynamic_pointer_cast<RRScheduler>(scheduler);
-    if (!rrScheduler) return;
+void Simulator::processContextSwitchComplete(const Event& event, std::shared_ptr<Scheduler> scheduler) {
+    switchInProgress = false;
+    scheduleProcess(event.getProcess(), scheduler);
+}
+
+void Simulator::processCgroupThrottle(const Event& event, std::shared_ptr<Scheduler> scheduler) {
+    auto process = event.getProcess();
+    if (event.getTag() != runningTag || scheduler->getCurrentProcess() != process) return;
     
+    chargeRunningProcess(scheduler);
+    int group = cgroupOf(*process);
+    for (int throttled : cgroupRun->throttleExhausted(group, currentTime)) {
+        Event unthrottleEvent(EventType::CGROUP_UNTHROTTLE, cgroupRun->refillTime(throttled, currentTime), nullptr,
+                              static_cast<unsigned long>(throttled));
+        eventQueue.push(unthrottleEvent);
+    }
+    
+    // Quota left (a new period began): look again at the next horizon
+    if (cgroupRun->throttledAncestor(group) < 0) {
+        int horizon = cgroupRun->quotaHorizon(group, currentTime);
+        if (horizon > 0) {
+            eventQueue.push(Event(EventType::CGROUP_THROTTLE, currentTime + horizon, process, runningTag));
+        }
+        return;
+    }
+    
+    if (params.verboseMode) {
+        logStateTransition(process, ProcessState::RUNNING, ProcessState::READY);
+    }
+    
+    scheduler->clearCurrentProcess();
+    runningTag = 0;
+    holdIfThrottled(process);
+}
+
+void Simulator::processCgroupUnthrottle(const Event& event, std::shared_ptr<Scheduler> scheduler) {
+    int group = static_cast<int>(event.getTag());
+    cgroupRun->unthrottle(group, currentTime);
+    
+    auto held = throttledProcesses.find(group);
+    if (held == throttledProcesses.end()) return;
+    std::vector<std::shared_ptr<Process>> released;
+    released.swap(held->second);
+    throttledProcesses.erase(held);
+    
+    // Back to the ready queue unless a group higher up is still throttled
+    for (auto& process : released) {
+        if (holdIfThrottled(process)) continue;
+        scheduler->addProcess(process);
+        readiedInBatch.push_back(process);
+    }
+}
+
+void Simulator::processFrequencyChange(const Event& event, std::shared_ptr<Scheduler> scheduler) {
     auto process = event.getProcess();
+    if (event.getTag() != runningTag || scheduler->getCurrentProcess() != process) return;
     
-    if (rrScheduler->getCurrentProcess() == process) {
-        if (params.verboseMode) {
-            logStateTransition(process, ProcessState::RUNNING, ProcessState::READY);
+    // The clock advance closed the governor's window; same speed: wait for the next one
+    if (dvfsRun->getSpeed() == runSpeed) {
+        int decision = dvfsRun->nextDecision(currentTime);
+        if (decision >= 0 && decision < runEnd) {
+            eventQueue.push(Event(EventType::FREQUENCY_CHANGE, decision, process, runningTag));
         }
-        
-        rrScheduler->addProcess(process);
-        rrScheduler->clearCurrentProcess();
-        contextSwitch(process, nullptr, scheduler);
+        return;
     }
+    
+    // New speed: charge the progress so far and re-time the rest of the dispatch
+    chargeRunningProcess(scheduler);
+    runningTag = ++nextTag;
+    armRunningProcess(process);
 }
 
-void Simulator::processContextSwitchComplete(const Event& event, std::shared_ptr<Scheduler> scheduler) {
-    scheduleNextEvent(scheduler);
+void Simulator::processSwapOutComplete(const Event& event, std::shared_ptr<Scheduler> scheduler) {
+    memoryRun->swapOutDone(event.getProcess());
+    rebalanceMemory(scheduler);
+}
+
+void Simulator::processSwapInComplete(const Event& event, std::shared_ptr<Scheduler> scheduler) {
+    auto process = event.getProcess();
+    memoryRun->swapInDone(process, currentTime);
+    
+    if (params.verboseMode) {
+        logStateTransition(process, ProcessState::BLOCKED, ProcessState::READY);
+    }
+    
+    if (holdIfThrottled(process)) return;
+    scheduler->addProcess(process);
+    readiedInBatch.push_back(process);
+}
+
+void Simulator::rebalanceMemory(std::shared_ptr<Scheduler> scheduler) {
+    for (const auto& action : memoryRun->rebalance(currentTime)) {
+        if (action.kind == MemoryAction::Kind::ADMIT) {
+            // Admitted arrivals go on as if they had just arrived
+            if (params.verboseMode) {
+                logStateTransition(action.process, action.process->getState(), ProcessState::READY);
+            }
+            if (holdIfThrottled(action.process)) continue;
+            scheduler->addProcess(action.process);
+            readiedInBatch.push_back(action.process);
+        } else {
+            EventType type = action.kind == MemoryAction::Kind::SWAP_IN ? EventType::SWAP_IN_COMPLETE
+                                                                        : EventType::SWAP_OUT_COMPLETE;
+            eventQueue.push(Event(type, action.time, action.process));
+        }
+    }
 }
 
 void Simulator::scheduleNextEvent(std::shared_ptr<Scheduler> scheduler) {
-    if (scheduler->hasCpuProcess()) return;
+    if (scheduler->hasCpuProcess() || switchInProgress) return;
     
-    auto nextProcess = scheduler->getNextProcess();
+    auto nextProcess = nextRunnableProcess(scheduler);
     if (!nextProcess) return;
     
     contextSwitch(nullptr, nextProcess, scheduler);
@@ -267,56 +1081,100 @@ void Simulator::scheduleNextEvent(std::shared_ptr<Scheduler> scheduler) {
 void Simulator::scheduleProcess(std::shared_ptr<Process> process, std::shared_ptr<Scheduler> scheduler) {
     if (!process) return;
     
-    if (params.verboseMode) {
+    if (params.verboseMode && process->getState() != ProcessState::RUNNING) {
         logStateTransition(process, ProcessState::READY, ProcessState::RUNNING);
     }
     
     process->setState(ProcessState::RUNNING);
     scheduler->setCurrentProcess(process);
+    scheduler->onDispatch(process, currentTime);
+    runStartTime = currentTime;
+    runningTag = ++nextTag;
     
+    int timeSlice = scheduler->getTimeSlice();
+    runSliceEnd = timeSlice > 0 ? currentTime + timeSlice : -1;
+    armRunningProcess(process);
+}
+
+void Simulator::armRunningProcess(std::shared_ptr<Process> process) {
+    // Time to finish the burst at the current frequency
     int remaining = process->getCurrentBurst().remaining;
+    if (dvfsRun) {
+        runSpeed = dvfsRun->getSpeed();
+        remaining = dvfsRun->timeFor(process->getId(), remaining, runSpeed);
+    }
+    EventType endType = EventType::CPU_BURST_COMPLETION;
     
-    if (auto rrScheduler = std::dynamic_pointer_cast<RRScheduler>(scheduler)) {
-        int timeSlice = rrScheduler->getCurrentTimeSlice();
-        if (timeSlice < remaining) {
-            remaining = timeSlice;
-        }
+    // Time-sliced schedulers: stop at the end of the slice unless the burst finishes first
+    if (runSliceEnd >= 0 && runSliceEnd - currentTime < remaining) {
+        remaining = runSliceEnd - currentTime;
+        endType = EventType::TIMER_INTERRUPT;
     }
     
-    int completionTime = currentTime + remaining;
-    Event completionEvent(EventType::CPU_BURST_COMPLETION, completionTime, process);
-    eventQueue.push(completionEvent);
+    runEnd = currentTime + remaining;
+    Event endEvent(endType, runEnd, process, runningTag);
+    eventQueue.push(endEvent);
     
-    process->updateRemainingTime(remaining);
+    // Stop to check the quotas of the process's groups if they could run out first
+    if (cgroupRun) {
+        int horizon = cgroupRun->quotaHorizon(cgroupOf(*process), currentTime);
+        if (horizon >= 0 && horizon < remaining) {
+            eventQueue.push(Event(EventType::CGROUP_THROTTLE, currentTime + horizon, process, runningTag));
+        }
+    }
+    
+    // Stop where the governor may change the frequency before the dispatch ends
+    if (dvfsRun) {
+        int decision = dvfsRun->nextDecision(currentTime);
+        if (decision >= 0 && decision < runEnd) {
+            eventQueue.push(Event(EventType::FREQUENCY_CHANGE, decision, process, runningTag));
+        }
+    }
 }
 
-void Simulator::checkPreemption(std::shared_ptr<Process> newProcess, std::shared_ptr<Scheduler> scheduler) {
-    if (!scheduler->isPreemptive()) return;
+bool Simulator::checkPreemption(std::shared_ptr<Process> newProcess, std::shared_ptr<Scheduler> scheduler) {
+    if (!scheduler->isPreemptive()) return false;
     
     auto currentProcess = scheduler->getCurrentProcess();
     
-    if (scheduler->shouldPreempt(newProcess)) {
-        if (params.verboseMode) {
-            logStateTransition(currentProcess, ProcessState::RUNNING, ProcessState::READY);
-        }
-        
-        scheduler->addProcess(currentProcess);
-        contextSwitch(currentProcess, newProcess, scheduler);
+    if (!scheduler->shouldPreempt(newProcess)) return false;
+    
+    if (params.verboseMode) {
+        logStateTransition(currentProcess, ProcessState::RUNNING, ProcessState::READY);
     }
+    
+    scheduler->clearCurrentProcess();
+    runningTag = 0;
+    scheduler->addProcess(currentProcess);
+    contextSwitch(currentProcess, nextRunnableProcess(scheduler), scheduler);
+    return true;
 }
 
 void Simulator::contextSwitch(std::shared_ptr<Process> oldProcess, std::shared_ptr<Process> newProcess,
                             std::shared_ptr<Scheduler> scheduler) {
+    (void)oldProcess;
     scheduler->clearCurrentProcess();
+    if (!newProcess) return;
+    
     scheduler->incrementContextSwitchCount();
+    switchInProgress = true;
+    
+    // Price the switch: same process as before, idle CPU, cache warmth
+    SwitchRequest request;
+    request.baseCost = processSwitchTime;
+    request.sameProcess = newProcess->getId() == lastCpuPid;
+    request.cpuWasIdle = lastCpuPid == 0 || cpuLastBusy < currentTime;
+    request.migrated = false;   // Single CPU
+    auto lastRun = lastRunEnd.find(newProcess->getId());
+    request.absence = lastRun != lastRunEnd.end() ? currentTime - lastRun->second : -1;
     
-    int completionTime = currentTime + processSwitchTime;
+    SwitchCost cost = switchCostModel->cost(request);
+    scheduler->recordSwitch(cost);
+    
+    // The CPU is occupied by the switch; the process starts running once it completes
+    int completionTime = currentTime + cost.total;
     Event completionEvent(EventType::CONTEXT_SWITCH_COMPLETE, completionTime, newProcess);
     eventQueue.push(completionEvent);
-    
-    if (newProcess) {
-        scheduleProcess(newProcess, scheduler);
-    }
 }
 
 void Simulator::logStateTransition(std::shared_ptr<Process> process, 
@@ -328,7 +1186,9 @@ void Simulator::logStateTransition(std::shared_ptr<Process> process,
                          ProcessStateStr[static_cast<int>(oldState)] + " to " + 
                          ProcessStateStr[static_cast<int>(newState)];
     
-    std::cout << message << std::endl;
+    if (output) {
+        *output << message << std::endl;
+    }
     
     if (verboseOutput.is_open()) {
         verboseOutput << message << std::endl;
@@ -336,35 +1196,86 @@ void Simulator::logStateTransition(std::shared_ptr<Process> process,
 }
 
 void Simulator::outputResults() const {
+    if (!output) return;
+    
     if (params.algorithm == "ALL") {
-        outputSchedulerResults(fcfsScheduler);
-        outputSchedulerResults(sjfScheduler);
-        outputSchedulerResults(srtnScheduler);
-        outputSchedulerResults(rr10Scheduler);
-        outputSchedulerResults(rr50Scheduler);
-        outputSchedulerResults(rr100Scheduler);
+        for (const auto& scheduler : schedulers) {
+            outputSchedulerResults(scheduler);
+        }
     } else {
         outputSchedulerResults(activeScheduler);
     }
 }
 
+void Simulator::outputResults(const std::string& algorithm) const {
+    auto scheduler = schedulerFor(algorithm);
+    if (!output || !scheduler) return;
+    
+    outputSchedulerResults(scheduler);
+}
+
 void Simulator::outputSchedulerResults(std::shared_ptr<Scheduler> scheduler) const {
-    std::cout << "\n" << scheduler->getName() << " Results:\n"
+    *output << "\n" << scheduler->getName() << " Results:\n"
               << "Total Time: " << scheduler->getTotalTime() << " time units\n"
               << "CPU Utilization: " << std::fixed << std::setprecision(2) 
               << scheduler->getCpuUtilization() << "%\n"
-              << "Context Switches: " << scheduler->getContextSwitchCount() << "\n\n";
+              << "Context Switches: " << scheduler->getContextSwitchCount() << "\n";
     
-    if (params.detailedMode) {
-        std::cout << "Process Details:\n";
-        for (const auto& process : scheduler->getAllProcesses()) {
-            std::cout << "Process " << process->getId() << ":\n"
-                      << "  Arrival Time: " << process->getArrivalTime() << "\n"
-                      << "  Service Time: " << process->getServiceTime() << "\n"
-                      << "  I/O Time: " << process->getIOTime() << "\n"
-                      << "  Finish Time: " << process->getFinishTime() << "\n"
-                      << "  Turnaround Time: " << process->getTurnaroundTime() << "\n"
-                      << "  Waiting Time: " << process->getWaitingTime() << "\n\n";
+    if (!switchCostModel->isFlat()) {
+        *output << "Switch Overhead (" << switchCostModel->describe() << "): "
+                  << scheduler->getSwitchOverhead() << " time units\n";
+        for (size_t kind = 0; kind < static_cast<size_t>(SwitchKind::COUNT); kind++) {
+            *output << "  " << SwitchKindStr[kind] << ": "
+                      << scheduler->getSwitchCount(static_cast<SwitchKind>(kind)) << ", "
+                      << scheduler->getSwitchTime(static_cast<SwitchKind>(kind)) << " time units\n";
+        }
+        *output << "  Cache refill (included above): " << scheduler->getCacheRefillTime() << " time units\n";
+    }
+    scheduler->outputAlgorithmResults(*output);
+    *output << "\n";
+    
+    auto jobs = jobRuns.find(scheduler.get());
+    if (jobs != jobRuns.end()) {
+        outputJobStats(*output, jobs->second);
+    }
+    
+    auto cgroupAccounting = cgroupRuns.find(scheduler.get());
+    if (cgroupAccounting != cgroupRuns.end()) {
+        cgroupAccounting->second.output(*output, scheduler->getTotalTime());
+    }
+    
+    auto memoryAccounting = memoryRuns.find(scheduler.get());
+    if (memoryAccounting != memoryRuns.end()) {
+        memoryAccounting->second.output(*output);
+    }
+    
+    auto dvfsAccounting = dvfsRuns.find(scheduler.get());
+    if (dvfsAccounting != dvfsRuns.end()) {
+        dvfsAccounting->second.output(*output, scheduler->getTotalTime());
+    }
+    
+    auto analytics = analyticsRuns.find(scheduler.get());
+    if (analytics != analyticsRuns.end()) {
+        outputAnalytics(*output, analytics->second);
+    }
+    
+    auto steadyRun = steadyStateRuns.find(scheduler.get());
+    if (steadyRun != steadyStateRuns.end()) {
+        outputSteadyState(steadyRun->second);
+    }
+    
+    auto details = detailRuns.find(scheduler.get());
+    if (details != detailRuns.end()) {
+        const ProcessResultTable& table = details->second;
+        *output << "Process Details:\n";
+        for (size_t i = 0; i < table.size(); i++) {
+            *output << "Process " << table.ids[i] << ":\n"
+                      << "  Arrival Time: " << table.arrival[i] << "\n"
+                      << "  Service Time: " << table.service[i] << "\n"
+                      << "  I/O Time: " << table.io[i] << "\n"
+                      << "  Finish Time: " << table.finish[i] << "\n"
+                      << "  Turnaround Time: " << table.turnaround[i] << "\n"
+                      << "  Waiting Time: " << table.waiting[i] << "\n\n";
         }
     }
 }
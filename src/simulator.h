@@ -4,24 +4,148 @@
 #include <memory>
 #include <vector>
 #include <fstream>
+#include <ostream>
+#include <unordered_map>
 #include "process.h"
 #include "event.h"
 #include "scheduler.h"
+#include "switchcost.h"
+#include "telemetry.h"
+#include "steadystate.h"
+#include "cgroup.h"
+#include "resultwriter.h"
+#include "analytics.h"
+#include "dvfs.h"
+#include "hostmemory.h"
+#include "jobs.h"
 
 // Forward declarations
-class FCFSScheduler;
-class SJFScheduler;
-class SRTNScheduler;
-class RRScheduler;
+struct SimulationSnapshot;
+
+// Default wait in the ready queue per priority promotion
+const int DEFAULT_AGING_INTERVAL = 50;
+
+// Default adaptive Round Robin bounds
+const int DEFAULT_TARGET_LATENCY = 1000;
+const int DEFAULT_MIN_GRANULARITY = 50;
+
+// Default CPU time a gang (process group) holds the CPU per turn
+const int DEFAULT_GANG_SLOT = 100;
+
+// Version stamp of the simulation model and report format. Every change
+// that alters the report of an existing input (results, added sections, -d
+// details or the layout of cache entries) bumps the minor number in the
+// same commit, so cached results (-R) are computed again.
+const char* const SIMULATOR_VERSION = "1.49";
 
 // Simulation parameters
 struct SimulationParams {
     bool detailedMode;
     bool verboseMode;
     std::string algorithm;
+    bool batchEvents;    // Drain all same-time events before one dispatch decision
+    
+    // Batch mode (many workloads per invocation)
+    std::string batchInput;    // Manifest file or directory of workload files
+    std::string batchOutput;   // Consolidated results file
+    int threads;               // Worker threads (0 = hardware concurrency)
+    
+    // Checkpoint / restore / fork-at-time-T
+    int checkpointTime;                 // Save a checkpoint at this time (-1 = off)
+    std::string checkpointFile;
+    std::string restoreFile;            // Resume from this checkpoint instead of stdin
+    int forkTime;                       // Fork what-if variants at this time (-1 = off)
+    std::vector<int> quantumVariants;   // RR quanta to continue with
+    std::vector<int> switchVariants;    // Context switch times to continue with
+    
+    // Replicated Monte Carlo runs
+    int replications;                   // Number of generated workloads (0 = off)
+    unsigned long long seed;            // Base seed of the replications
+    std::string generatorSpec;          // Distribution spec (see workloadgen.h)
+    
+    // Linux scheduler trace import
+    std::string traceFile;              // perf sched / ftrace text dump to replay
+    int traceMicrosPerUnit;             // Trace microseconds per simulated time unit
+    std::string exportFile;             // Write the imported workload in input format
+    
+    // Burst prediction (PSJF / PSRTN)
+    double predictionAlpha;             // Weight of the latest burst in the average
+    double initialPrediction;           // Prediction before any burst was observed
+    
+    // Priority scheduling
+    int agingInterval;                  // Ready-queue wait per one-level promotion (0 = off)
+    
+    // Adaptive Round Robin
+    int targetLatency;                  // Every waiting process runs within this time
+    int minGranularity;                 // Shortest quantum handed out
+    
+    // Gang scheduling
+    int gangSlot;                       // CPU time per gang turn
+    
+    // Context switch cost model ("flat" or "affinity[,key=value...]", see switchcost.h)
+    std::string switchCostSpec;
+    
+    // Windowed telemetry
+    int telemetryWindow;                // Window length in time units (0 = off)
+    std::string telemetryFile;          // CSV time series output
+    
+    // Steady-state estimation with early termination
+    double steadyStatePrecision;        // Target CI half-width / mean (0 = off)
+    
+    // Multi-core model (see multicore.h)
+    int cores;                          // Simulated cores (0 = single-CPU model)
+    int placementWindow;                // Placement lookahead (0 = context switch time)
+    
+    // Closed-system runs (see closedloop.h)
+    std::vector<int> closedClients;     // Client populations to simulate (empty = off)
+    double thinkTime;                   // Mean think time between a job and the next
+    int closedHorizon;                  // Simulated time per population
+    
+    // Round Robin quantum search (see tuner.h)
+    std::string tuningSpec;             // Objective and search settings (empty = off)
+    
+    // Frequency governor and power model (see dvfs.h)
+    std::string dvfsSpec;               // Empty = fixed top frequency, no energy report
+    
+    // Post-run fairness and slowdown analytics (see analytics.h)
+    int starvationLimit;                // Ready-queue wait that counts as starvation (-1 = off)
+    
+    // Structured per-process results (see resultwriter.h)
+    std::string resultsFile;            // .csv, .jsonl or .bin (empty = off)
+    
+    // On-disk result cache (see resultcache.h)
+    std::string cacheDirectory;         // Empty = off
     
     SimulationParams() 
-        : detailedMode(false), verboseMode(false), algorithm("ALL") {}
+        : detailedMode(false), verboseMode(false), algorithm("ALL"), batchEvents(true),
+          batchOutput("batch_results.csv"), threads(0), checkpointTime(-1), forkTime(-1),
+          replications(0), seed(1), traceMicrosPerUnit(1),
+          predictionAlpha(0.5), initialPrediction(100.0), agingInterval(DEFAULT_AGING_INTERVAL),
+          targetLatency(DEFAULT_TARGET_LATENCY), minGranularity(DEFAULT_MIN_GRANULARITY),
+          gangSlot(DEFAULT_GANG_SLOT),
+          switchCostSpec("flat"), telemetryWindow(0), telemetryFile("telemetry.csv"),
+          steadyStatePrecision(0.0), cores(0), placementWindow(0),
+          thinkTime(100.0), closedHorizon(100000), starvationLimit(-1) {}
+};
+
+// Source of processes created during a run (closed-loop clients): told of
+// every termination, it may return the next process to submit
+class JobSource {
+public:
+    virtual ~JobSource() = default;
+    virtual std::shared_ptr<Process> onCompletion(const Process& process, int time) = 0;
+};
+
+// Summary statistics of one scheduler run
+struct RunSummary {
+    std::string algorithm;
+    std::string name;
+    int processes;
+    int totalTime;
+    double cpuUtilization;
+    int contextSwitches;
+    double avgTurnaround;
+    double avgWaiting;
 };
 
 // Simulator class
@@ -33,13 +157,21 @@ private:
     // Event queue
     EventQueue eventQueue;
     
-    // Schedulers
-    std::shared_ptr<FCFSScheduler> fcfsScheduler;
-    std::shared_ptr<SJFScheduler> sjfScheduler;
-    std::shared_ptr<SRTNScheduler> srtnScheduler;
-    std::shared_ptr<RRScheduler> rr10Scheduler;
-    std::shared_ptr<RRScheduler> rr50Scheduler;
-    std::shared_ptr<RRScheduler> rr100Scheduler;
+    // CPU dispatch state
+    bool switchInProgress;           // A context switch is occupying the CPU
+    int runStartTime;                // When the running process last started or was charged
+    unsigned long runningTag;        // Tag of the running dispatch (stale events carry older tags)
+    unsigned long nextTag;
+    int runSliceEnd;                 // When the running process's time slice ends (-1 = no slice)
+    int runEnd;                      // When the running dispatch's end event fires
+    std::vector<std::shared_ptr<Process>> readiedInBatch;  // Processes that became ready this batch
+    
+    // Engine statistics
+    long long processedEvents;
+    long long dispatchDecisions;
+    
+    // Schedulers, one per algorithm code in algorithmNames() order
+    std::vector<std::shared_ptr<Scheduler>> schedulers;
     
     // Active scheduler (based on selected algorithm)
     std::shared_ptr<Scheduler> activeScheduler;
@@ -47,27 +179,116 @@ private:
     // Processes
     std::vector<std::shared_ptr<Process>> processes;
     
-    // Process switch time (context switch overhead)
+    // Process switch time (context switch overhead) and its cost model
     int processSwitchTime;
+    std::shared_ptr<const SwitchCostModel> switchCostModel;
+    
+    // Cache warmth bookkeeping for the switch cost model
+    int lastCpuPid;                             // Process that last ran (0 = none yet)
+    int cpuLastBusy;                            // When a process last ran on the CPU
+    std::unordered_map<int, int> lastRunEnd;    // Process ID -> when it last ran
+    
+    // Windowed telemetry of the current run
+    std::unique_ptr<Telemetry> telemetry;
+    std::ofstream telemetryOutput;
+    
+    // Per-process results of every finished run, written in the background,
+    // and the analytics of each scheduler's run
+    std::unique_ptr<ResultWriter> resultWriter;
+    std::unordered_map<const Scheduler*, RunAnalytics> analyticsRuns;
+    
+    // What each scheduler's report shows of its own run: the processes are
+    // shared and reset by the next run, so -d details and job statistics
+    // are taken when the run finishes
+    std::unordered_map<const Scheduler*, ProcessResultTable> detailRuns;
+    std::unordered_map<const Scheduler*, std::vector<JobStats>> jobRuns;
+    int blockedCount;                           // Processes doing I/O
+    int completedCount;                         // Processes terminated in this run
+    
+    // Steady-state estimation: detector and how much of the workload ran
+    struct SteadyStateRun {
+        SteadyStateDetector detector;
+        bool stoppedEarly = false;
+        int completedProcesses = 0;
+        int totalProcesses = 0;
+        long long simulatedWork = 0;     // CPU time served
+        long long totalWork = 0;         // CPU time demanded by the workload
+    };
+    std::unordered_map<const Scheduler*, SteadyStateRun> steadyStateRuns;
+    SteadyStateRun* steadyState;                // Current run (nullptr = off)
+    bool stopRequested;
+    
+    // Dependency edges of the workload: who waits for whom, and how many
+    // predecessors each held-back process still waits for
+    std::unordered_map<int, std::vector<std::shared_ptr<Process>>> dependents;
+    std::unordered_map<int, int> pendingPredecessors;
+    
+    // Control groups of the workload, accounting of each run, and ready
+    // processes held back while a group on their path is throttled
+    std::shared_ptr<const CgroupHierarchy> cgroups;
+    std::unordered_map<const Scheduler*, CgroupAccounting> cgroupRuns;
+    CgroupAccounting* cgroupRun;                // Current run (nullptr = no hierarchy)
+    std::unordered_map<int, std::vector<std::shared_ptr<Process>>> throttledProcesses;   // Group index -> held back
+    
+    // Frequency scaling: power model, energy accounting of each run, and the
+    // speed the running process has had since runStartTime
+    std::shared_ptr<const DvfsModel> dvfsModel;
+    std::unordered_map<const Scheduler*, DvfsAccounting> dvfsRuns;
+    DvfsAccounting* dvfsRun;                    // Current run (nullptr = no frequency scaling)
+    int runSpeed;
+    
+    // Host memory: admission queue and swapping of each run (see hostmemory.h)
+    MemoryConfig memoryConfig;
+    std::unordered_map<const Scheduler*, MemoryAccounting> memoryRuns;
+    MemoryAccounting* memoryRun;                // Current run (nullptr = no memory model)
+    
+    // Processes submitted from inside the run (nullptr = fixed workload)
+    std::shared_ptr<JobSource> jobSource;
     
     // Simulation parameters
     SimulationParams params;
     
+    // Results and state transitions go here (nullptr = silent)
+    std::ostream* output;
+    
     // Verbose output stream
     std::ofstream verboseOutput;
     
     // Helper methods
+    std::shared_ptr<Scheduler> schedulerFor(const std::string& algorithm) const;
+    std::string algorithmFor(std::shared_ptr<Scheduler> scheduler) const;
+    void startTelemetry(std::shared_ptr<Scheduler> scheduler);
     void runScheduler(std::shared_ptr<Scheduler> scheduler);
+    void beginRun(std::shared_ptr<Scheduler> scheduler);
+    void buildDependencies();
+    void releaseDependents(const Process& process);
+    int cgroupOf(const Process& process) const { return cgroups->indexOf(process.getCgroup()); }
+    bool holdIfThrottled(std::shared_ptr<Process> process);
+    void rebalanceMemory(std::shared_ptr<Scheduler> scheduler);
+    std::shared_ptr<Process> nextRunnableProcess(std::shared_ptr<Scheduler> scheduler);
+    void advance(std::shared_ptr<Scheduler> scheduler, int stopTime);
+    void advanceClock(std::shared_ptr<Scheduler> scheduler, int newTime);
+    void finishRun(std::shared_ptr<Scheduler> scheduler);
+    void processEvent(const Event& event, std::shared_ptr<Scheduler> scheduler);
+    void dispatch(std::shared_ptr<Scheduler> scheduler);
+    void chargeRunningProcess(std::shared_ptr<Scheduler> scheduler);
     void processArrival(const Event& event, std::shared_ptr<Scheduler> scheduler);
     void processCPUBurstCompletion(const Event& event, std::shared_ptr<Scheduler> scheduler);
     void processIOCompletion(const Event& event, std::shared_ptr<Scheduler> scheduler);
     void processTimerInterrupt(const Event& event, std::shared_ptr<Scheduler> scheduler);
     void processContextSwitchComplete(const Event& event, std::shared_ptr<Scheduler> scheduler);
+    void processCgroupThrottle(const Event& event, std::shared_ptr<Scheduler> scheduler);
+    void processCgroupUnthrottle(const Event& event, std::shared_ptr<Scheduler> scheduler);
+    void processFrequencyChange(const Event& event, std::shared_ptr<Scheduler> scheduler);
+    void processSwapOutComplete(const Event& event, std::shared_ptr<Scheduler> scheduler);
+    void processSwapInComplete(const Event& event, std::shared_ptr<Scheduler> scheduler);
     void scheduleNextEvent(std::shared_ptr<Scheduler> scheduler);
     void scheduleProcess(std::shared_ptr<Process> process, std::shared_ptr<Scheduler> scheduler);
-    void checkPreemption(std::shared_ptr<Process> newProcess, std::shared_ptr<Scheduler> scheduler);
+    void armRunningProcess(std::shared_ptr<Process> process);
+    bool checkPreemption(std::shared_ptr<Process> newProcess, std::shared_ptr<Scheduler> scheduler);
     void contextSwitch(std::shared_ptr<Process> oldProcess, std::shared_ptr<Process> newProcess,
                       std::shared_ptr<Scheduler> scheduler);
+    void outputSteadyState(const SteadyStateRun& run) const;
     void logStateTransition(std::shared_ptr<Process> process, ProcessState oldState, ProcessState newState);
     void outputSchedulerResults(std::shared_ptr<Scheduler> scheduler) const;
     
@@ -84,11 +305,67 @@ public:
     // Run the simulation
     void run();
     
+    // Step-wise run of the active scheduler (checkpointing): start, run all
+    // events up to and including 'time', then finish the remainder
+    void start();
+    void runUntil(int time);
+    void finish();
+    
+    // Add a process to a step-wise run (multi-core placement, closed-loop
+    // clients); it must not arrive before the current time. Untracked
+    // processes are not kept once they terminate, so runs of unbounded
+    // length keep constant memory, and are left out of the results.
+    void addArrival(std::shared_ptr<Process> process, bool track = true);
+    void setJobSource(std::shared_ptr<JobSource> source) { jobSource = source; }
+    
+    // Control group hierarchy the processes' cgroup= IDs refer to (weights
+    // for SHARE, quotas enforced under every algorithm; nullptr = none)
+    void setCgroups(std::shared_ptr<const CgroupHierarchy> hierarchy);
+    std::shared_ptr<const CgroupHierarchy> getCgroups() const { return cgroups; }
+    
+    // Host memory limit and swap device (memory=, swap_rate= on the input header)
+    void setMemory(const MemoryConfig& config) { memoryConfig = config; }
+    
+    // Energy accounting of the active scheduler's run (nullptr without -P)
+    const DvfsAccounting* getDvfsAccounting() const;
+    
+    // Capture the full state of a step-wise run, or resume one in a freshly
+    // constructed simulator. Snapshots share burst lists with the processes
+    // (copy-on-write), so many forks of one snapshot are cheap.
+    std::shared_ptr<const SimulationSnapshot> checkpoint() const;
+    bool restore(const SimulationSnapshot& snapshot);
+    
+    // Parameters that may change when continuing from a checkpoint
+    void setSwitchTime(int switchTime);
+    bool setTimeQuantum(int quantum);
+    
+    // Stream for results and verbose state transitions (default std::cout,
+    // nullptr = no output; embedders read results through the API instead)
+    void setOutput(std::ostream* stream) { output = stream; }
+    
     // Output results
     void outputResults() const;
     
+    // Output the results of one algorithm's run (one section of -a ALL)
+    void outputResults(const std::string& algorithm) const;
+    
+    // Summary of the active scheduler's last run
+    RunSummary summarize() const;
+    
+    // Algorithm codes accepted by -a, in the order ALL runs them
+    static const std::vector<std::string>& algorithmNames();
+    static std::shared_ptr<Scheduler> createScheduler(const std::string& algorithm, int switchTime);
+    
+    int getCurrentTime() const { return currentTime; }
+    int getCompletedCount() const { return completedCount; }
+    int getProcessCount() const { return static_cast<int>(processes.size()); }
+    
     // Get active scheduler (for testing/debugging)
     std::shared_ptr<Scheduler> getActiveScheduler() const { return activeScheduler; }
+    
+    // Engine statistics of the last run (for benchmarking)
+    long long getProcessedEvents() const { return processedEvents; }
+    long long getDispatchDecisions() const { return dispatchDecisions; }
 };
 
 #endif // SIMULATOR_H
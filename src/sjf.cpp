@@ -38,4 +38,8 @@ void SJFScheduler::updateWaitingTime(int timeElapsed) {
     for (auto& process : readyQueue) {
         process->incrementWaitingTime(timeElapsed);
     }
+}
+
+std::vector<std::shared_ptr<Process>> SJFScheduler::getReadyProcesses() const {
+    return std::vector<std::shared_ptr<Process>>(readyQueue.begin(), readyQueue.end());
 }
\ No newline at end of file
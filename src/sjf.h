@@ -19,9 +19,10 @@ public:
     bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
     bool isPreemptive() const override { return false; }
     void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
     
     // SJF specific methods
-    size_t getReadyQueueSize() const { return readyQueue.size(); }
+    size_t getReadyQueueSize() const override { return readyQueue.size(); }
 };
 
 #endif // SJF_H
\ No newline at end of file
@@ -43,4 +43,8 @@ void SRTNScheduler::updateWaitingTime(int timeElapsed) {
     for (auto& process : readyQueue) {
         process->incrementWaitingTime(timeElapsed);
     }
+}
+
+std::vector<std::shared_ptr<Process>> SRTNScheduler::getReadyProcesses() const {
+    return std::vector<std::shared_ptr<Process>>(readyQueue.begin(), readyQueue.end());
 }
\ No newline at end of file
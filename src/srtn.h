@@ -19,9 +19,10 @@ public:
     bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
     bool isPreemptive() const override { return true; }
     void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
     
     // SRTN specific methods
-    size_t getReadyQueueSize() const { return readyQueue.size(); }
+    size_t getReadyQueueSize() const override { return readyQueue.size(); }
 };
 
 #endif // SRTN_H
\ No newline at end of file
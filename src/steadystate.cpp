@@ -0,0 +1,87 @@
+#include "steadystate.h"
+#include <cmath>
+#include <limits>
+#include "montecarlo.h"
+
+SteadyStateDetector::SteadyStateDetector(double relativePrecision)
+    : precision(relativePrecision),
+      observations(0),
+      sums(1, 0.0),
+      squares(1, 0.0),
+      waitingSums(1, 0.0),
+      pendingTurnaround(0.0),
+      pendingWaiting(0.0),
+      pending(0),
+      truncation(0),
+      mean(0.0),
+      halfWidth(0.0),
+      meanWaiting(0.0),
+      converged(false) {
+}
+
+void SteadyStateDetector::add(double turnaroundTime, double waitingTime, int time) {
+    observations++;
+    pendingTurnaround += turnaroundTime;
+    pendingWaiting += waitingTime;
+    if (++pending < MSER_BATCH) {
+        return;
+    }
+    
+    // Close the batch: one more Z_j
+    double z = pendingTurnaround / MSER_BATCH;
+    sums.push_back(sums.back() + z);
+    squares.push_back(squares.back() + z * z);
+    waitingSums.push_back(waitingSums.back() + pendingWaiting);
+    batchEnd.push_back(time);
+    pendingTurnaround = 0.0;
+    pendingWaiting = 0.0;
+    pending = 0;
+}
+
+int SteadyStateDetector::getWarmupEndTime() const {
+    return truncation > 0 ? batchEnd[truncation / MSER_BATCH - 1] : 0;
+}
+
+bool SteadyStateDetector::evaluate() {
+    converged = false;
+    
+    // MSER-5 over the batch means, with suffix sums taken from the prefix sums
+    size_t k = batchEnd.size();
+    if (k < 2) {
+        return false;
+    }
+    
+    size_t best = 0;
+    double bestValue = std::numeric_limits<double>::max();
+    for (size_t d = 0; d <= k / 2; d++) {
+        double remaining = static_cast<double>(k - d);
+        double suffixSum = sums[k] - sums[d];
+        double sse = squares[k] - squares[d] - suffixSum * suffixSum / remaining;
+        double value = sse / (remaining * remaining);
+        if (value < bestValue) {
+            bestValue = value;
+            best = d;
+        }
+    }
+    truncation = best * MSER_BATCH;
+    
+    // Batch means over whole MSER batches after the warm-up
+    size_t perBatch = (k - best) / BATCHES;
+    if (perBatch * MSER_BATCH < MIN_PER_BATCH) {
+        return false;
+    }
+    
+    // Drop the oldest leftovers so every batch has the same size
+    size_t first = k - perBatch * BATCHES;
+    MetricAccumulator batchMeans;
+    for (size_t b = 0; b < BATCHES; b++) {
+        size_t begin = first + b * perBatch;
+        batchMeans.add((sums[begin + perBatch] - sums[begin]) / perBatch);
+    }
+    
+    mean = batchMeans.getMean();
+    halfWidth = batchMeans.getHalfWidth95();
+    meanWaiting = (waitingSums[k] - waitingSums[first]) / (perBatch * BATCHES * MSER_BATCH);
+    converged = mean > 0.0 && halfWidth <= precision * mean;
+    return converged;
+}
@@ -0,0 +1,63 @@
+#ifndef STEADYSTATE_H
+#define STEADYSTATE_H
+
+#include <cstddef>
+#include <vector>
+
+// Steady-state estimate of the mean turnaround (and waiting) time
+// Observations are per-process turnaround times in completion order. The
+// warm-up period is cut with MSER-5: observations are grouped into batches
+// of five and the truncation point d (at most half the batches) minimises
+//   MSER(d) = sum over batches j > d of (Z_j - mean)^2 / (k - d)^2
+// The remaining MSER batches are split into BATCHES batch means, whose
+// Student t interval gives the 95% confidence half-width. The estimate has
+// converged when the half-width falls below the requested relative precision.
+// Only running prefix sums over the MSER batches are kept, so an evaluation
+// never revisits single observations.
+class SteadyStateDetector {
+private:
+    static constexpr size_t MSER_BATCH = 5;
+    static constexpr size_t BATCHES = 20;
+    static constexpr size_t MIN_PER_BATCH = 5;
+    
+    double precision;                 // Target half-width / mean
+    size_t observations;
+    
+    // Prefix sums over the completed MSER batches (element j covers batches < j)
+    std::vector<double> sums;         // Of the batch means Z_j
+    std::vector<double> squares;      // Of Z_j^2
+    std::vector<double> waitingSums;  // Of the batches' total waiting time
+    std::vector<int> batchEnd;        // Completion time of each batch's last observation
+    
+    // Observations of the batch being filled
+    double pendingTurnaround;
+    double pendingWaiting;
+    size_t pending;
+    
+    // Result of the last evaluation
+    size_t truncation;                // Observations discarded as warm-up
+    double mean;
+    double halfWidth;
+    double meanWaiting;
+    bool converged;
+    
+public:
+    SteadyStateDetector(double relativePrecision = 0.05);
+    
+    void add(double turnaroundTime, double waitingTime, int time);
+    
+    // Re-run MSER-5 and the batch-means interval; true once precise enough
+    bool evaluate();
+    
+    size_t getObservations() const { return observations; }
+    size_t getTruncation() const { return truncation; }
+    int getWarmupEndTime() const;
+    double getPrecision() const { return precision; }
+    double getMean() const { return mean; }
+    double getHalfWidth() const { return halfWidth; }
+    double getMeanWaiting() const { return meanWaiting; }
+    bool hasConverged() const { return converged; }
+    size_t getBatches() const { return BATCHES; }
+};
+
+#endif // STEADYSTATE_H
@@ -0,0 +1,127 @@
+#include "stride.h"
+#include <algorithm>
+#include <sstream>
+
+StrideScheduler::StrideScheduler(int contextSwitchTime, int quantum)
+    : Scheduler("Stride", contextSwitchTime),
+      virtualTime(0),
+      nextSequence(0),
+      timeQuantum(quantum) {
+    
+    // Append time quantum to the name
+    std::stringstream ss;
+    ss << "Stride (quantum=" << quantum << ")";
+    name = ss.str();
+}
+
+bool StrideScheduler::later(const Entry& a, const Entry& b) {
+    // Heap comparator: std heaps keep the "largest" on top, so invert
+    if (a.pass != b.pass) return a.pass > b.pass;
+    return a.sequence > b.sequence;
+}
+
+void StrideScheduler::addProcess(std::shared_ptr<Process> process) {
+    StridePass& pass = passes[process->getId()];
+    pass.value = std::max(pass.value, virtualTime);
+    
+    heap.push_back({pass.value, nextSequence++, process});
+    std::push_heap(heap.begin(), heap.end(), later);
+    process->setState(ProcessState::READY);
+}
+
+std::shared_ptr<Process> StrideScheduler::getNextProcess() {
+    if (heap.empty()) {
+        return nullptr;
+    }
+    
+    // Lowest pass wins
+    std::pop_heap(heap.begin(), heap.end(), later);
+    Entry entry = heap.back();
+    heap.pop_back();
+    virtualTime = entry.pass;
+    
+    return entry.process;
+}
+
+bool StrideScheduler::shouldPreempt(std::shared_ptr<Process>) {
+    // Stride preempts when the time slice expires, not on arrivals
+    return false;
+}
+
+void StrideScheduler::updateWaitingTime(int timeElapsed) {
+    // Update waiting time for all processes in the ready queue
+    for (auto& entry : heap) {
+        entry.process->incrementWaitingTime(timeElapsed);
+    }
+}
+
+std::vector<std::shared_ptr<Process>> StrideScheduler::getReadyProcesses() const {
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(heap.size());
+    for (const auto& entry : heap) {
+        processes.push_back(entry.process);
+    }
+    return processes;
+}
+
+void StrideScheduler::onCPUTime(std::shared_ptr<Process> process, int time) {
+    passes[process->getId()].advance(time, process->getTickets());
+}
+
+void StrideScheduler::resetPolicyState() {
+    heap.clear();
+    passes.clear();
+    virtualTime = 0;
+    nextSequence = 0;
+}
+
+std::vector<double> StrideScheduler::getPolicyState() const {
+    // Virtual time, sequence counter, (pid, pass, remainder) in pid order,
+    // then (pass, sequence) of each heap entry in getReadyProcesses() order
+    std::vector<double> state = {static_cast<double>(virtualTime), static_cast<double>(nextSequence),
+                                 static_cast<double>(passes.size())};
+    
+    std::vector<std::pair<int, StridePass>> entries(passes.begin(), passes.end());
+    std::sort(entries.begin(), entries.end(),
+              [](const std::pair<int, StridePass>& a, const std::pair<int, StridePass>& b) { return a.first < b.first; });
+    for (const auto& entry : entries) {
+        state.push_back(entry.first);
+        state.push_back(static_cast<double>(entry.second.value));
+        state.push_back(static_cast<double>(entry.second.remainder));
+    }
+    for (const auto& entry : heap) {
+        state.push_back(static_cast<double>(entry.pass));
+        state.push_back(static_cast<double>(entry.sequence));
+    }
+    return state;
+}
+
+bool StrideScheduler::setPolicyState(const std::vector<double>& state) {
+    // The ready processes were already added in heap order; restore their keys
+    if (state.size() < 3) {
+        return false;
+    }
+    size_t numPasses = static_cast<size_t>(state[2]);
+    if (state.size() != 3 + 3 * numPasses + 2 * heap.size()) {
+        return false;
+    }
+    
+    virtualTime = static_cast<long long>(state[0]);
+    nextSequence = static_cast<unsigned long long>(state[1]);
+    passes.clear();
+    size_t i = 3;
+    for (size_t j = 0; j < numPasses; j++, i += 3) {
+        StridePass& pass = passes[static_cast<int>(state[i])];
+        pass.value = static_cast<long long>(state[i + 1]);
+        pass.remainder = static_cast<long long>(state[i + 2]);
+    }
+    
+    // Processes were pushed in the stored heap order with non-decreasing
+    // keys, so no sift happened and positions still match
+    for (auto& entry : heap) {
+        entry.pass = static_cast<long long>(state[i]);
+        entry.sequence = static_cast<unsigned long long>(state[i + 1]);
+        i += 2;
+    }
+    return std::is_heap(heap.begin(), heap.end(), later);
+}
@@ -0,0 +1,69 @@
+#ifndef STRIDE_H
+#define STRIDE_H
+
+#include <unordered_map>
+#include <vector>
+#include "scheduler.h"
+
+// Pass value of a stride-scheduled entity: running t time units advances it
+// by t * STRIDE1 / tickets. The remainder of the division is carried into
+// the next charge, so the pass is exact over a whole run and nearby ticket
+// counts stay apart even where STRIDE1 / tickets is below 2.
+struct StridePass {
+    static const long long STRIDE1 = 1 << 20;
+    
+    long long value;
+    long long remainder;    // Charged STRIDE1 * time short of one more pass unit
+    
+    StridePass() : value(0), remainder(0) {}
+    
+    void advance(int time, int tickets) {
+        long long charged = STRIDE1 * time + remainder;
+        value += charged / tickets;
+        remainder = charged % tickets;
+    }
+};
+
+// Stride Scheduler (proportional share, time-sliced, deterministic)
+// Each process advances a pass value by STRIDE1 / tickets per time unit it
+// runs (see StridePass); every quantum the ready process with the lowest pass runs. Ready
+// processes are kept in a binary min-heap on (pass, arrival order). A
+// process joining the ready queue starts no lower than the pass of the last
+// dispatched process, so time spent blocked does not build up credit.
+class StrideScheduler : public Scheduler {
+private:
+    struct Entry {
+        long long pass;
+        unsigned long long sequence;   // Ties are broken in FIFO order
+        std::shared_ptr<Process> process;
+    };
+    
+    std::vector<Entry> heap;
+    std::unordered_map<int, StridePass> passes;   // Process ID -> pass
+    long long virtualTime;
+    unsigned long long nextSequence;
+    int timeQuantum;
+    
+    static bool later(const Entry& a, const Entry& b);
+    
+public:
+    StrideScheduler(int contextSwitchTime, int quantum);
+    
+    // Implementation of abstract methods
+    void addProcess(std::shared_ptr<Process> process) override;
+    std::shared_ptr<Process> getNextProcess() override;
+    bool shouldPreempt(std::shared_ptr<Process> newProcess) override;
+    bool isPreemptive() const override { return true; }
+    void updateWaitingTime(int timeElapsed) override;
+    std::vector<std::shared_ptr<Process>> getReadyProcesses() const override;
+    size_t getReadyQueueSize() const override { return heap.size(); }
+    int getTimeSlice() const override { return timeQuantum; }
+    
+    // Pass accounting
+    void onCPUTime(std::shared_ptr<Process> process, int time) override;
+    void resetPolicyState() override;
+    std::vector<double> getPolicyState() const override;
+    bool setPolicyState(const std::vector<double>& state) override;
+};
+
+#endif // STRIDE_H
@@ -0,0 +1,104 @@
+#include "switchcost.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+std::shared_ptr<const SwitchCostModel> SwitchCostModel::create(const std::string& spec) {
+    std::stringstream ss(spec);
+    std::string item;
+    std::getline(ss, item, ',');
+    
+    if (item == "flat" && ss.eof()) {
+        return std::make_shared<FlatSwitchCost>();
+    }
+    if (item != "affinity") {
+        std::cerr << "Error: Unknown switch cost model '" << item << "'" << std::endl;
+        return nullptr;
+    }
+    
+    auto model = std::make_shared<AffinitySwitchCost>();
+    while (std::getline(ss, item, ',')) {
+        size_t eq = item.find('=');
+        char* end = nullptr;
+        long value = eq == std::string::npos ? -1 : std::strtol(item.c_str() + eq + 1, &end, 10);
+        
+        if (eq == std::string::npos || eq + 1 == item.size() || *end != '\0' ||
+            !model->set(item.substr(0, eq), static_cast<int>(value))) {
+            std::cerr << "Error: Invalid switch cost setting '" << item << "'" << std::endl;
+            return nullptr;
+        }
+    }
+    return model;
+}
+
+SwitchKind SwitchCostModel::classify(const SwitchRequest& request) {
+    if (request.cpuWasIdle) {
+        return SwitchKind::IDLE_DISPATCH;
+    }
+    return request.sameProcess ? SwitchKind::RESUME : SwitchKind::PROCESS_SWITCH;
+}
+
+SwitchCost FlatSwitchCost::cost(const SwitchRequest& request) const {
+    return {classify(request), request.baseCost, 0};
+}
+
+AffinitySwitchCost::AffinitySwitchCost()
+    : switchPercent(100),
+      resumePercent(20),
+      idlePercent(50),
+      refillPercent(100),
+      decay(500) {
+}
+
+bool AffinitySwitchCost::set(const std::string& key, int value) {
+    if (key == "decay") {
+        if (value <= 0) return false;
+        decay = value;
+        return true;
+    }
+    if (value < 0) {
+        return false;
+    }
+    
+    if (key == "switch") {
+        switchPercent = value;
+    } else if (key == "resume") {
+        resumePercent = value;
+    } else if (key == "idle") {
+        idlePercent = value;
+    } else if (key == "refill") {
+        refillPercent = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+SwitchCost AffinitySwitchCost::cost(const SwitchRequest& request) const {
+    SwitchKind kind = classify(request);
+    
+    int percent = switchPercent;
+    if (kind == SwitchKind::RESUME) {
+        percent = resumePercent;
+    } else if (kind == SwitchKind::IDLE_DISPATCH) {
+        percent = idlePercent;
+    }
+    
+    // Fraction of the cache that went cold while the process was away
+    double coldness = 1.0;
+    if (request.absence >= 0 && !request.migrated) {
+        coldness = 1.0 - std::exp(-static_cast<double>(request.absence) / decay);
+    }
+    
+    int fixed = static_cast<int>(std::lround(request.baseCost * percent / 100.0));
+    int refill = static_cast<int>(std::lround(request.baseCost * refillPercent / 100.0 * coldness));
+    return {kind, fixed + refill, refill};
+}
+
+std::string AffinitySwitchCost::describe() const {
+    std::stringstream ss;
+    ss << "affinity: switch=" << switchPercent << "%, resume=" << resumePercent
+       << "%, idle=" << idlePercent << "%, refill=" << refillPercent << "%, decay=" << decay;
+    return ss.str();
+}
@@ -0,0 +1,83 @@
+#ifndef SWITCHCOST_H
+#define SWITCHCOST_H
+
+#include <memory>
+#include <string>
+
+// Kinds of dispatch, for the switch overhead breakdown
+enum class SwitchKind {
+    PROCESS_SWITCH,   // Another process ran until now: save it, load the new one
+    RESUME,           // The process that last ran on the CPU gets it back
+    IDLE_DISPATCH,    // The CPU was idle: nothing to save
+    COUNT
+};
+
+// String representation of switch kinds
+const std::string SwitchKindStr[] = {
+    "Process switches",
+    "Resumes",
+    "Idle dispatches"
+};
+
+// What the simulator knows about a dispatch
+struct SwitchRequest {
+    int baseCost;       // Configured context switch time
+    bool sameProcess;   // Incoming process is the one that last ran on this CPU
+    bool cpuWasIdle;    // The CPU was idle before this dispatch
+    bool migrated;      // Incoming process last ran on another CPU
+    int absence;        // Time since the incoming process last ran (-1 = never ran)
+};
+
+// Cost of one dispatch
+struct SwitchCost {
+    SwitchKind kind;
+    int total;          // Time the CPU is occupied by the switch
+    int refill;         // Part of total spent warming caches
+};
+
+// Pluggable context switch cost model
+class SwitchCostModel {
+public:
+    virtual ~SwitchCostModel() = default;
+    
+    virtual SwitchCost cost(const SwitchRequest& request) const = 0;
+    virtual std::string describe() const = 0;
+    virtual bool isFlat() const { return false; }
+    
+    // Build a model from "flat" or "affinity[,key=value...]"; nullptr on error
+    static std::shared_ptr<const SwitchCostModel> create(const std::string& spec);
+    
+protected:
+    static SwitchKind classify(const SwitchRequest& request);
+};
+
+// Every dispatch costs the configured switch time (the original behaviour)
+class FlatSwitchCost : public SwitchCostModel {
+public:
+    SwitchCost cost(const SwitchRequest& request) const override;
+    std::string describe() const override { return "flat"; }
+    bool isFlat() const override { return true; }
+};
+
+// Cache-affinity model. The fixed part of a dispatch is a percentage of the
+// switch time that depends on its kind; on top of that comes a cache refill
+// penalty that grows with the time since the incoming process last ran:
+//   refill = switch time * refill% * (1 - exp(-absence / decay))
+// A process that never ran, or that migrated from another CPU, starts cold.
+class AffinitySwitchCost : public SwitchCostModel {
+private:
+    int switchPercent;     // Save + load, another process ran until now
+    int resumePercent;     // Same process gets the CPU back
+    int idlePercent;       // Load only, CPU was idle
+    int refillPercent;     // Extra cost of a fully cold cache
+    int decay;             // Time constant of cache warmth
+    
+public:
+    AffinitySwitchCost();
+    
+    bool set(const std::string& key, int value);
+    SwitchCost cost(const SwitchRequest& request) const override;
+    std::string describe() const override;
+};
+
+#endif // SWITCHCOST_H
@@ -0,0 +1,82 @@
+#include "telemetry.h"
+#include <algorithm>
+#include <iomanip>
+
+Telemetry::Telemetry(int length, size_t capacity, const std::string& runLabel, std::ostream& output, int startTime)
+    : windowLength(length),
+      label(runLabel),
+      out(output),
+      ring(std::max<size_t>(capacity, 1)),
+      head(0),
+      count(0),
+      current() {
+    
+    // Windows are aligned to multiples of the window length
+    current.start = startTime - startTime % windowLength;
+    current.end = current.start + windowLength;
+}
+
+void Telemetry::advance(int from, int to, bool cpuBusy, size_t readyCount, int blockedCount) {
+    while (from < to) {
+        int chunkEnd = std::min(to, current.end);
+        int length = chunkEnd - from;
+        
+        if (cpuBusy) {
+            current.busyTime += length;
+        }
+        current.readyArea += static_cast<long long>(readyCount) * length;
+        current.blockedArea += static_cast<long long>(blockedCount) * length;
+        current.maxReady = std::max(current.maxReady, static_cast<int>(readyCount));
+        
+        from = chunkEnd;
+        if (from == current.end) {
+            closeWindow();
+        }
+    }
+    
+    // The state at 'to' is the start of the next interval
+    current.maxReady = std::max(current.maxReady, static_cast<int>(readyCount));
+}
+
+void Telemetry::closeWindow() {
+    if (count == ring.size()) {
+        flush();
+    }
+    ring[(head + count) % ring.size()] = current;
+    count++;
+    
+    int start = current.end;
+    current = TelemetryWindow();
+    current.start = start;
+    current.end = start + windowLength;
+}
+
+void Telemetry::flush() {
+    for (; count > 0; count--, head = (head + 1) % ring.size()) {
+        const TelemetryWindow& window = ring[head];
+        double length = window.end - window.start;
+        
+        out << label << "," << window.start << "," << window.end << ","
+            << std::fixed << std::setprecision(2) << 100.0 * window.busyTime / length << ","
+            << window.readyArea / length << "," << window.maxReady << ","
+            << window.blockedArea / length << "," << window.completions << ","
+            << std::setprecision(4) << window.completions * 1000.0 / length << "\n";
+    }
+}
+
+void Telemetry::finish(int endTime) {
+    // Keep a partial last window unless it is empty
+    if (endTime > current.start) {
+        current.end = endTime;
+        closeWindow();
+    } else if (current.completions > 0 && count > 0) {
+        ring[(head + count - 1) % ring.size()].completions += current.completions;
+    }
+    flush();
+    out.flush();
+}
+
+void Telemetry::writeHeader(std::ostream& output) {
+    output << "algorithm,window_start,window_end,utilization,avg_ready,max_ready,avg_blocked,"
+           << "completions,throughput_per_1000\n";
+}
@@ -0,0 +1,55 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// One closed window of simulated time
+struct TelemetryWindow {
+    int start;
+    int end;
+    int busyTime;              // Time a process ran on the CPU
+    long long readyArea;       // Integral of the ready-queue length over the window
+    long long blockedArea;     // Integral of the blocked-process count over the window
+    int maxReady;
+    int completions;           // Processes that terminated in the window
+};
+
+// Windowed time series of one scheduler run
+// The event loop reports every clock advance with the state that held over
+// it; the values are integrated per window of fixed simulated length. Closed
+// windows go into a fixed-size ring buffer that is drained to the CSV stream
+// when it fills up and at the end of the run, so memory stays bounded on
+// arbitrarily long runs.
+class Telemetry {
+private:
+    int windowLength;
+    std::string label;
+    std::ostream& out;
+    
+    std::vector<TelemetryWindow> ring;
+    size_t head;               // Oldest unwritten window
+    size_t count;
+    
+    TelemetryWindow current;
+    
+    void closeWindow();
+    void flush();
+    
+public:
+    Telemetry(int length, size_t capacity, const std::string& runLabel, std::ostream& output, int startTime = 0);
+    
+    // State that held over [from, to)
+    void advance(int from, int to, bool cpuBusy, size_t readyCount, int blockedCount);
+    
+    // A process terminated at the current window's time
+    void recordCompletion() { current.completions++; }
+    
+    // Close the last (possibly partial) window and write everything out
+    void finish(int endTime);
+    
+    static void writeHeader(std::ostream& output);
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,119 @@
+#include "threadpool.h"
+
+namespace {
+    // Pool and worker index of the current thread (null pool outside any pool)
+    thread_local const void* currentPool = nullptr;
+    thread_local size_t currentWorker = 0;
+}
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : pendingTasks(0),
+      queuedTasks(0),
+      nextQueue(0),
+      stopping(false) {
+    
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) {
+            threadCount = 1;
+        }
+    }
+    
+    for (size_t i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    size_t index;
+    if (currentPool == this) {
+        index = currentWorker;
+    } else {
+        index = nextQueue.fetch_add(1) % queues.size();
+    }
+    
+    pendingTasks.fetch_add(1);
+    {
+        // Count under the state mutex so a sleeping worker cannot miss the wake-up
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queuedTasks.fetch_add(1);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    workAvailable.notify_one();
+}
+
+bool ThreadPool::popTask(size_t index, std::function<void()>& task) {
+    // Own deque first, newest task
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        if (!queues[index]->tasks.empty()) {
+            task = std::move(queues[index]->tasks.back());
+            queues[index]->tasks.pop_back();
+            return true;
+        }
+    }
+    
+    // Steal the oldest task from the other workers
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        size_t victim = (index + offset) % queues.size();
+        std::lock_guard<std::mutex> lock(queues[victim]->mutex);
+        if (!queues[victim]->tasks.empty()) {
+            task = std::move(queues[victim]->tasks.front());
+            queues[victim]->tasks.pop_front();
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+    
+    while (true) {
+        std::function<void()> task;
+        
+        if (popTask(index, task)) {
+            queuedTasks.fetch_sub(1);
+            task();
+            
+            if (pendingTasks.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this] { return stopping || queuedTasks.load() > 0; });
+        if (stopping && queuedTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pendingTasks.load() == 0; });
+}
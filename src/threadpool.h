@@ -0,0 +1,54 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool
+// Every worker owns a task deque. A worker pops its own newest task (LIFO, so
+// tasks spawned by a running task stay cache-warm) and, when its deque is
+// empty, steals the oldest task from another worker (FIFO).
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    std::atomic<size_t> pendingTasks;   // Submitted but not yet finished
+    std::atomic<size_t> queuedTasks;    // Submitted but not yet started
+    std::atomic<size_t> nextQueue;
+    bool stopping;
+    
+    void workerLoop(size_t index);
+    bool popTask(size_t index, std::function<void()>& task);
+    
+public:
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    // Queue a task; tasks submitted from a worker go to that worker's deque
+    void submit(std::function<void()> task);
+    
+    // Block until every submitted task (including ones they spawn) has finished
+    void wait();
+    
+    size_t getThreadCount() const { return workers.size(); }
+};
+
+#endif // THREADPOOL_H
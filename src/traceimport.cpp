@@ -0,0 +1,321 @@
+#include "traceimport.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    // Value of "key=" where the key starts a token (so "pid=" does not match "prev_pid=")
+    bool findField(const std::string& line, size_t from, const char* key, std::string& value) {
+        size_t keyLength = std::strlen(key);
+        size_t pos = line.find(key, from);
+        
+        while (pos != std::string::npos) {
+            if (pos == 0 || std::isspace(static_cast<unsigned char>(line[pos - 1]))) {
+                size_t start = pos + keyLength;
+                size_t end = line.find_first_of(" \t", start);
+                value = line.substr(start, end == std::string::npos ? std::string::npos : end - start);
+                return true;
+            }
+            pos = line.find(key, pos + 1);
+        }
+        return false;
+    }
+    
+    // PID of a "comm:pid" token (comm may itself contain ':')
+    int pidFromCommToken(const std::string& token) {
+        size_t colon = token.rfind(':');
+        if (colon == std::string::npos) return -1;
+        return std::atoi(token.c_str() + colon + 1);
+    }
+    
+    // Timestamp token "SSSS.UUUUUU:" that precedes the event name, in microseconds
+    bool parseTimestamp(const std::string& line, size_t eventPos, long long& micros) {
+        size_t end = line.rfind(':', eventPos);
+        // perf prints "sched:sched_switch:", skip the subsystem prefix
+        while (end != std::string::npos && end > 0 && !std::isdigit(static_cast<unsigned char>(line[end - 1]))) {
+            end = (end == 0) ? std::string::npos : line.rfind(':', end - 1);
+        }
+        if (end == std::string::npos || end == 0) return false;
+        
+        size_t start = line.find_last_of(" \t", end - 1);
+        start = (start == std::string::npos) ? 0 : start + 1;
+        
+        std::string token = line.substr(start, end - start);
+        size_t dot = token.find('.');
+        if (dot == std::string::npos) return false;
+        
+        long long seconds = std::atoll(token.substr(0, dot).c_str());
+        std::string fraction = token.substr(dot + 1, 6);
+        fraction.append(6 - fraction.size(), '0');
+        micros = seconds * 1000000LL + std::atoll(fraction.c_str());
+        return true;
+    }
+}
+
+TraceImporter::TraceImporter(std::istream& in, const TraceImportOptions& importOptions)
+    : input(in),
+      options(importOptions),
+      tasksSeen(0),
+      haveStart(false),
+      traceStart(0),
+      lastTime(0),
+      linesRead(0),
+      eventsUsed(0) {
+}
+
+TraceImporter::TaskState& TraceImporter::task(int pid, long long time) {
+    auto it = tasks.find(pid);
+    if (it == tasks.end()) {
+        it = tasks.emplace(pid, TaskState()).first;
+        it->second.sequence = tasksSeen++;
+        it->second.arrival = time;
+    }
+    return it->second;
+}
+
+void TraceImporter::switchOut(int pid, bool blocked, long long time) {
+    if (pid <= 0) return;
+    
+    // A task already on the CPU when the trace started arrived at trace start
+    bool known = tasks.count(pid) > 0;
+    TaskState& state = task(pid, traceStart);
+    if (!known) {
+        state.running = true;
+        state.runStart = traceStart;
+    }
+    
+    if (state.running) {
+        state.cpuAccum += time - state.runStart;
+        state.running = false;
+    }
+    
+    // Last switch-out of an exiting task
+    if (state.exited) {
+        finishTask(state, time);
+        tasks.erase(pid);
+        return;
+    }
+    
+    // Preempted tasks stay runnable and keep extending the same CPU burst
+    if (blocked) {
+        state.sleeping = true;
+        state.sleepStart = time;
+    }
+}
+
+void TraceImporter::switchIn(int pid, long long time) {
+    if (pid <= 0) return;
+    
+    // A task first seen being switched in became runnable no later than now
+    TaskState& state = task(pid, time);
+    
+    // Missing wakeup: the task is evidently runnable again
+    if (state.sleeping) {
+        wakeup(pid, time);
+    }
+    
+    state.running = true;
+    state.runStart = time;
+}
+
+void TraceImporter::wakeup(int pid, long long time) {
+    if (pid <= 0) return;
+    
+    TaskState& state = task(pid, time);
+    if (!state.sleeping) return;
+    
+    state.sleeping = false;
+    long long ioTime = time - state.sleepStart;
+    
+    // Sleeps shorter than one simulated unit are folded into the CPU burst
+    if (ioTime >= options.microsPerUnit && state.cpuAccum > 0) {
+        state.bursts.push_back(state.cpuAccum);
+        state.bursts.push_back(ioTime);
+        state.cpuAccum = 0;
+    }
+}
+
+void TraceImporter::exitTask(int pid) {
+    // The task keeps the CPU until its final sched_switch
+    auto it = tasks.find(pid);
+    if (it != tasks.end()) {
+        it->second.exited = true;
+    }
+}
+
+void TraceImporter::finishTask(TaskState& state, long long time) {
+    if (state.running) {
+        state.cpuAccum += time - state.runStart;
+        state.running = false;
+    }
+    if (state.cpuAccum > 0) {
+        state.bursts.push_back(state.cpuAccum);
+    } else if (!state.bursts.empty()) {
+        // Drop the trailing I/O burst so the sequence ends with CPU
+        state.bursts.pop_back();
+    }
+    
+    if (!state.bursts.empty()) {
+        finished.push_back({state.sequence, state.arrival, std::move(state.bursts)});
+    }
+}
+
+bool TraceImporter::processLine(const std::string& line) {
+    size_t pos;
+    long long time;
+    
+    if ((pos = line.find("sched_switch:")) != std::string::npos) {
+        if (!parseTimestamp(line, pos, time)) return false;
+        if (!haveStart) {
+            haveStart = true;
+            traceStart = time;
+        }
+        
+        int prevPid = -1;
+        int nextPid = -1;
+        std::string prevState;
+        std::string value;
+        
+        if (findField(line, pos, "prev_pid=", value)) {
+            prevPid = std::atoi(value.c_str());
+            findField(line, pos, "prev_state=", prevState);
+            if (findField(line, pos, "next_pid=", value)) {
+                nextPid = std::atoi(value.c_str());
+            }
+        } else {
+            // Older layout: "prev_comm:prev_pid [prio] STATE ==> next_comm:next_pid [prio]"
+            size_t arrow = line.find("==>", pos);
+            if (arrow == std::string::npos) return false;
+            
+            std::string left = line.substr(pos + std::strlen("sched_switch:"), arrow - pos - std::strlen("sched_switch:"));
+            size_t bracket = left.rfind('[');
+            if (bracket == std::string::npos) return false;
+            
+            size_t tokenEnd = left.find_last_not_of(" \t", bracket - 1);
+            size_t tokenStart = left.find_last_of(" \t", tokenEnd);
+            tokenStart = (tokenStart == std::string::npos) ? 0 : tokenStart + 1;
+            prevPid = pidFromCommToken(left.substr(tokenStart, tokenEnd - tokenStart + 1));
+            
+            size_t stateStart = left.find_first_not_of(" \t", left.find(']', bracket) + 1);
+            if (stateStart != std::string::npos) {
+                prevState = left.substr(stateStart, left.find_first_of(" \t", stateStart) - stateStart);
+            }
+            
+            std::string right = line.substr(arrow + 3);
+            size_t rightStart = right.find_first_not_of(" \t");
+            size_t rightEnd = right.find('[');
+            if (rightStart == std::string::npos || rightEnd == std::string::npos) return false;
+            std::string nextToken = right.substr(rightStart, rightEnd - rightStart);
+            nextToken.erase(nextToken.find_last_not_of(" \t") + 1);
+            nextPid = pidFromCommToken(nextToken);
+        }
+        
+        if (prevPid < 0 || nextPid < 0) return false;
+        
+        // R / R+ means preempted; anything else (S, D, T, X, ...) blocks
+        bool blocked = !prevState.empty() && prevState[0] != 'R';
+        lastTime = time;
+        switchOut(prevPid, blocked, time);
+        switchIn(nextPid, time);
+        eventsUsed++;
+        return true;
+    }
+    
+    if ((pos = line.find("sched_wakeup")) != std::string::npos) {
+        size_t colon = line.find(':', pos);
+        if (colon == std::string::npos || !parseTimestamp(line, pos, time)) return false;
+        if (!haveStart) {
+            haveStart = true;
+            traceStart = time;
+        }
+        
+        std::string value;
+        int pid;
+        if (findField(line, colon, "pid=", value)) {
+            pid = std::atoi(value.c_str());
+        } else {
+            // Older layout: "comm:pid [prio] ..."
+            size_t start = line.find_first_not_of(" \t", colon + 1);
+            size_t end = line.find('[', start);
+            if (start == std::string::npos || end == std::string::npos) return false;
+            std::string token = line.substr(start, end - start);
+            token.erase(token.find_last_not_of(" \t") + 1);
+            pid = pidFromCommToken(token);
+        }
+        
+        lastTime = time;
+        wakeup(pid, time);
+        eventsUsed++;
+        return true;
+    }
+    
+    if ((pos = line.find("sched_process_exit:")) != std::string::npos) {
+        std::string value;
+        if (!parseTimestamp(line, pos, time) || !findField(line, pos, "pid=", value)) return false;
+        
+        lastTime = time;
+        exitTask(std::atoi(value.c_str()));
+        eventsUsed++;
+        return true;
+    }
+    
+    // Other events and header/comment lines are ignored
+    return true;
+}
+
+bool TraceImporter::import(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime) {
+    std::string line;
+    long long malformed = 0;
+    
+    while (std::getline(input, line)) {
+        linesRead++;
+        if (!line.empty() && line[0] == '#') continue;
+        if (!processLine(line)) {
+            malformed++;
+        }
+    }
+    
+    // Tasks still alive at the end of the trace
+    for (auto& entry : tasks) {
+        finishTask(entry.second, lastTime);
+    }
+    tasks.clear();
+    
+    if (finished.empty()) {
+        std::cerr << "Error: No scheduler events found in trace" << std::endl;
+        return false;
+    }
+    if (malformed > 0) {
+        std::cerr << "Warning: Skipped " << malformed << " malformed trace lines" << std::endl;
+    }
+    
+    // Tasks still alive were finished in hash order; IDs follow first appearance
+    std::sort(finished.begin(), finished.end(), [](const FinishedTask& a, const FinishedTask& b) {
+        return a.sequence < b.sequence;
+    });
+    
+    // Convert microseconds to simulated units (CPU and I/O bursts at least 1 unit)
+    const long long unit = options.microsPerUnit;
+    auto toUnits = [unit](long long micros) {
+        return static_cast<int>(std::max(1LL, (micros + unit / 2) / unit));
+    };
+    
+    int pid = 1;
+    for (const auto& entry : finished) {
+        auto process = std::make_shared<Process>(pid++, static_cast<int>((entry.arrival - traceStart) / unit));
+        const auto& bursts = entry.bursts;
+        for (size_t i = 0; i < bursts.size(); i++) {
+            if (i % 2 == 0) {
+                process->addCPUBurst(toUnits(bursts[i]));
+            } else {
+                process->addIOBurst(toUnits(bursts[i]));
+            }
+        }
+        processes.push_back(process);
+    }
+    finished.clear();
+    
+    contextSwitchTime = options.contextSwitchTime;
+    return true;
+}
@@ -0,0 +1,83 @@
+#ifndef TRACEIMPORT_H
+#define TRACEIMPORT_H
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "process.h"
+
+// Options for importing Linux scheduler traces
+struct TraceImportOptions {
+    int microsPerUnit;        // Trace microseconds per simulated time unit
+    int contextSwitchTime;    // Switch time to simulate the imported workload with
+    
+    TraceImportOptions() : microsPerUnit(1), contextSwitchTime(0) {}
+};
+
+// Importer for `perf sched script` / ftrace text dumps
+// Reads sched_switch, sched_wakeup(_new) and sched_process_exit lines one at
+// a time (both the key=value and the older "comm:pid [prio]" layouts) and
+// rebuilds each task's CPU/IO burst sequence: on-CPU time between a switch-in
+// and a blocking switch-out is a CPU burst (preemptions do not end it), time
+// from blocking to the next wakeup is an I/O burst. Only per-task state is
+// kept, never the trace text, so memory follows the imported workload
+// (tasks and bursts) rather than the size of the dump.
+// Tasks are renumbered 1..N in order of first appearance in the trace.
+class TraceImporter {
+private:
+    struct TaskState {
+        long long sequence;       // Order of first appearance
+        long long arrival;        // First appearance (us)
+        bool running;
+        long long runStart;
+        bool sleeping;
+        long long sleepStart;
+        long long cpuAccum;       // Open CPU burst (us)
+        bool exited;              // Exit seen, waiting for the final switch-out
+        std::vector<long long> bursts;   // Closed bursts, alternating CPU/IO (us)
+        
+        TaskState() : sequence(0), arrival(0), running(false), runStart(0), sleeping(false),
+                      sleepStart(0), cpuAccum(0), exited(false) {}
+    };
+    
+    struct FinishedTask {
+        long long sequence;
+        long long arrival;
+        std::vector<long long> bursts;
+    };
+    
+    std::istream& input;
+    TraceImportOptions options;
+    std::unordered_map<int, TaskState> tasks;
+    std::vector<FinishedTask> finished;
+    long long tasksSeen;
+    
+    bool haveStart;
+    long long traceStart;
+    long long lastTime;
+    
+    // Statistics
+    long long linesRead;
+    long long eventsUsed;
+    
+    TaskState& task(int pid, long long time);
+    void switchOut(int pid, bool blocked, long long time);
+    void switchIn(int pid, long long time);
+    void wakeup(int pid, long long time);
+    void exitTask(int pid);
+    void finishTask(TaskState& state, long long time);
+    bool processLine(const std::string& line);
+    
+public:
+    TraceImporter(std::istream& in, const TraceImportOptions& importOptions);
+    
+    // Import the whole trace into the same form Parser::parse produces
+    bool import(std::vector<std::shared_ptr<Process>>& processes, int& contextSwitchTime);
+    
+    long long getLinesRead() const { return linesRead; }
+    long long getEventsUsed() const { return eventsUsed; }
+};
+
+#endif // TRACEIMPORT_H
@@ -0,0 +1,493 @@
+#include "tuner.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "threadpool.h"
+
+namespace {
+    // Quanta every report compared by hand before the tuner
+    const int HAND_PICKED_QUANTA[] = {10, 50, 100};
+    
+    // Smallest workload prefix successive halving simulates
+    const size_t MIN_PREFIX = 16;
+    
+    // Switch times the quantum may be searched under
+    const int MAX_TUNING_SWITCH_TIME = 1000000;
+    const size_t MAX_TUNING_SWITCH_TIMES = 16;
+    
+    // Golden ratio conjugate, (sqrt(5) - 1) / 2
+    const double INV_PHI = 0.6180339887498949;
+    
+    int parseInt(const std::string& text, bool& ok) {
+        char* end = nullptr;
+        long value = std::strtol(text.c_str(), &end, 10);
+        ok = ok && !text.empty() && *end == '\0' && value > 0 && value <= 1000000000L;
+        return static_cast<int>(value);
+    }
+}
+
+bool TuningSpec::parse(const std::string& text) {
+    std::stringstream ss(text);
+    std::string item;
+    std::getline(ss, item, ',');
+    
+    // Objective: statistic-metric
+    size_t dash = item.find('-');
+    std::string statistic = item.substr(0, dash);
+    metric = dash == std::string::npos ? "" : item.substr(dash + 1);
+    bool ok = metric == "turnaround" || metric == "waiting";
+    if (statistic == "mean") {
+        percentile = 0;
+    } else if (statistic == "max") {
+        percentile = 100;
+    } else if (statistic.size() > 1 && statistic[0] == 'p') {
+        percentile = parseInt(statistic.substr(1), ok);
+        ok = ok && percentile < 100;
+    } else {
+        ok = false;
+    }
+    if (!ok) {
+        std::cerr << "Error: Invalid tuning objective '" << item
+                  << "' (expected mean-, max- or pNN- followed by turnaround or waiting)" << std::endl;
+        return false;
+    }
+    
+    while (std::getline(ss, item, ',')) {
+        size_t eq = item.find('=');
+        std::string key = item.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : item.substr(eq + 1);
+        ok = eq != std::string::npos;
+        
+        if (key == "util") {
+            char* end = nullptr;
+            minUtilization = std::strtod(value.c_str(), &end);
+            ok = ok && !value.empty() && *end == '\0' && minUtilization >= 0.0 && minUtilization <= 100.0;
+        } else if (key == "range") {
+            size_t colon = value.find(':');
+            ok = ok && colon != std::string::npos;
+            if (ok) {
+                minQuantum = parseInt(value.substr(0, colon), ok);
+                maxQuantum = parseInt(value.substr(colon + 1), ok);
+                ok = ok && minQuantum < maxQuantum;
+            }
+        } else if (key == "switch") {
+            // Colon-separated, as commas separate the settings
+            switchTimes.clear();
+            std::stringstream list(value);
+            std::string entry;
+            while (ok && std::getline(list, entry, ':')) {
+                char* end = nullptr;
+                long time = std::strtol(entry.c_str(), &end, 10);
+                ok = !entry.empty() && *end == '\0' && time >= 0 && time <= MAX_TUNING_SWITCH_TIME;
+                switchTimes.push_back(static_cast<int>(time));
+            }
+            std::sort(switchTimes.begin(), switchTimes.end());
+            switchTimes.erase(std::unique(switchTimes.begin(), switchTimes.end()), switchTimes.end());
+            ok = ok && !switchTimes.empty() && switchTimes.size() <= MAX_TUNING_SWITCH_TIMES;
+        } else if (key == "method" && (value == "golden" || value == "halving")) {
+            method = value == "golden" ? TuningMethod::GOLDEN : TuningMethod::HALVING;
+        } else if (key == "candidates") {
+            candidates = parseInt(value, ok);
+            ok = ok && candidates >= 2 && candidates <= 1024;
+        } else {
+            ok = false;
+        }
+        
+        if (!ok) {
+            std::cerr << "Error: Invalid tuning setting '" << item << "'" << std::endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+std::string TuningSpec::objectiveName() const {
+    if (percentile == 0) {
+        return "mean " + metric;
+    } else if (percentile == 100) {
+        return "max " + metric;
+    }
+    return "p" + std::to_string(percentile) + " " + metric;
+}
+
+QuantumTuner::QuantumTuner(const SimulationParams& simulationParams, const TuningSpec& tuningSpec,
+                           const std::vector<std::shared_ptr<Process>>& workload, int switchTime,
+                           std::shared_ptr<const CgroupHierarchy> hierarchy, const MemoryConfig& memory)
+    : params(simulationParams), spec(tuningSpec), processes(workload), switchTimes(tuningSpec.switchTimes),
+      cgroups(hierarchy), memoryConfig(memory) {
+    if (switchTimes.empty()) {
+        switchTimes.push_back(switchTime);
+    }
+    params.verboseMode = false;
+    params.detailedMode = false;
+    params.algorithm = "RR10";
+    
+    arrivalOrder.resize(processes.size());
+    for (size_t i = 0; i < processes.size(); i++) {
+        arrivalOrder[i] = i;
+    }
+    std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(), [this](size_t a, size_t b) {
+        return processes[a]->getArrivalTime() < processes[b]->getArrivalTime();
+    });
+}
+
+bool QuantumTuner::better(const QuantumEvaluation& a, const QuantumEvaluation& b) {
+    if (a.feasible != b.feasible) {
+        return a.feasible;
+    }
+    if (!a.feasible) {
+        return a.utilization > b.utilization;
+    }
+    if (a.objective != b.objective) {
+        return a.objective < b.objective;
+    }
+    // Equal objectives: the one that spends less on switching
+    return a.switchOverhead < b.switchOverhead;
+}
+
+QuantumEvaluation QuantumTuner::simulate(const TuningPoint& point, size_t prefix) const {
+    // The earliest arrivals, kept in input order; runs mutate their processes,
+    // so every run gets copies (which share the burst lists)
+    std::vector<size_t> chosen(arrivalOrder.begin(), arrivalOrder.begin() + prefix);
+    std::sort(chosen.begin(), chosen.end());
+    std::vector<std::shared_ptr<Process>> copies;
+    copies.reserve(prefix);
+    for (size_t index : chosen) {
+        copies.push_back(std::make_shared<Process>(*processes[index]));
+    }
+    
+    Simulator simulator(point.first);
+    simulator.setOutput(nullptr);
+    simulator.initialize(copies);
+    simulator.setParams(params);
+    if (cgroups && !cgroups->empty()) {
+        simulator.setCgroups(cgroups);
+    }
+    simulator.setMemory(memoryConfig);
+    simulator.setTimeQuantum(point.second);
+    simulator.run();
+    
+    std::vector<double> values;
+    values.reserve(copies.size());
+    for (const auto& process : copies) {
+        values.push_back(spec.metric == "waiting" ? process->getWaitingTime() : process->getTurnaroundTime());
+    }
+    
+    QuantumEvaluation evaluation;
+    evaluation.quantum = point.second;
+    evaluation.switchTime = point.first;
+    evaluation.processes = prefix;
+    if (spec.percentile == 0) {
+        double sum = 0.0;
+        for (double value : values) {
+            sum += value;
+        }
+        evaluation.objective = sum / std::max<size_t>(values.size(), 1);
+    } else {
+        // Nearest-rank percentile
+        size_t rank = static_cast<size_t>(std::ceil(spec.percentile / 100.0 * values.size()));
+        rank = std::min(std::max<size_t>(rank, 1), values.size());
+        std::nth_element(values.begin(), values.begin() + (rank - 1), values.end());
+        evaluation.objective = values[rank - 1];
+    }
+    
+    auto scheduler = simulator.getActiveScheduler();
+    evaluation.utilization = scheduler->getCpuUtilization();
+    evaluation.contextSwitches = scheduler->getContextSwitchCount();
+    evaluation.switchOverhead = scheduler->getSwitchOverhead();
+    evaluation.totalTime = scheduler->getTotalTime();
+    evaluation.feasible = evaluation.utilization >= spec.minUtilization;
+    return evaluation;
+}
+
+std::vector<QuantumEvaluation> QuantumTuner::evaluate(ThreadPool& pool, const std::vector<TuningPoint>& points,
+                                                      size_t prefix) {
+    // Each point runs once; repeats and points already run on the whole workload are copied
+    std::vector<QuantumEvaluation> results(points.size());
+    std::vector<size_t> source(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        source[i] = std::find(points.begin(), points.end(), points[i]) - points.begin();
+        auto it = fullRuns.find(points[i]);
+        if (prefix == processes.size() && it != fullRuns.end()) {
+            results[i] = it->second;
+            source[i] = points.size();
+        } else if (source[i] == i) {
+            pool.submit([this, i, prefix, &points, &results] { results[i] = simulate(points[i], prefix); });
+        }
+    }
+    pool.wait();
+    
+    for (size_t i = 0; i < points.size(); i++) {
+        if (source[i] == points.size()) continue;
+        if (source[i] != i) {
+            results[i] = results[source[i]];
+            continue;
+        }
+        trace.push_back(results[i]);
+        if (prefix == processes.size()) {
+            fullRuns[points[i]] = results[i];
+        }
+    }
+    return results;
+}
+
+std::vector<QuantumEvaluation> QuantumTuner::bestPerSwitchTime() const {
+    std::vector<QuantumEvaluation> best;
+    for (int switchTime : switchTimes) {
+        auto it = fullRuns.lower_bound({switchTime, 0});
+        QuantumEvaluation result = it->second;
+        for (; it != fullRuns.end() && it->first.first == switchTime; ++it) {
+            if (better(it->second, result)) {
+                result = it->second;
+            }
+        }
+        best.push_back(result);
+    }
+    return best;
+}
+
+std::vector<int> QuantumTuner::logGrid(int low, int high, int points) const {
+    std::vector<int> grid;
+    double logLow = std::log(static_cast<double>(low));
+    double logHigh = std::log(static_cast<double>(high));
+    for (int i = 0; i < points; i++) {
+        double x = logLow + (logHigh - logLow) * i / std::max(points - 1, 1);
+        int quantum = std::min(high, std::max(low, static_cast<int>(std::lround(std::exp(x)))));
+        if (grid.empty() || grid.back() != quantum) {
+            grid.push_back(quantum);
+        }
+    }
+    return grid;
+}
+
+std::vector<QuantumEvaluation> QuantumTuner::goldenSection(ThreadPool& pool) {
+    // Coarse grid first, all switch times and points at once; the objective
+    // need not be unimodal over the whole range, only around the best grid point
+    int points = std::max(9, static_cast<int>(pool.getThreadCount()));
+    std::vector<int> grid = logGrid(spec.minQuantum, spec.maxQuantum, points);
+    std::vector<TuningPoint> step;
+    for (int switchTime : switchTimes) {
+        for (int quantum : grid) {
+            step.push_back({switchTime, quantum});
+        }
+    }
+    std::vector<QuantumEvaluation> gridRuns = evaluate(pool, step, processes.size());
+    
+    // Golden-section search in log(quantum) between the neighbours of each
+    // switch time's best grid point; the searches take their steps together
+    struct Bracket {
+        int switchTime;
+        double a, b, c, d;
+    };
+    std::vector<Bracket> brackets;
+    for (size_t s = 0; s < switchTimes.size(); s++) {
+        const QuantumEvaluation* runs = &gridRuns[s * grid.size()];
+        size_t best = 0;
+        for (size_t i = 1; i < grid.size(); i++) {
+            if (better(runs[i], runs[best])) {
+                best = i;
+            }
+        }
+        double a = std::log(static_cast<double>(grid[best == 0 ? 0 : best - 1]));
+        double b = std::log(static_cast<double>(grid[std::min(best + 1, grid.size() - 1)]));
+        brackets.push_back({switchTimes[s], a, b, b - INV_PHI * (b - a), a + INV_PHI * (b - a)});
+    }
+    
+    auto quantumAt = [](double x) { return static_cast<int>(std::lround(std::exp(x))); };
+    step.clear();
+    for (const auto& bracket : brackets) {
+        step.push_back({bracket.switchTime, quantumAt(bracket.c)});
+        step.push_back({bracket.switchTime, quantumAt(bracket.d)});
+    }
+    evaluate(pool, step, processes.size());
+    while (true) {
+        step.clear();
+        for (auto& bracket : brackets) {
+            if (quantumAt(bracket.b) - quantumAt(bracket.a) <= 3) continue;
+            
+            double& a = bracket.a;
+            double& b = bracket.b;
+            double& c = bracket.c;
+            double& d = bracket.d;
+            if (better(fullRuns[{bracket.switchTime, quantumAt(c)}], fullRuns[{bracket.switchTime, quantumAt(d)}])) {
+                b = d;
+                d = c;
+                c = b - INV_PHI * (b - a);
+                step.push_back({bracket.switchTime, quantumAt(c)});
+            } else {
+                a = c;
+                c = d;
+                d = a + INV_PHI * (b - a);
+                step.push_back({bracket.switchTime, quantumAt(d)});
+            }
+        }
+        if (step.empty()) break;
+        evaluate(pool, step, processes.size());
+    }
+    
+    // The last few integers of each bracket together
+    step.clear();
+    for (const auto& bracket : brackets) {
+        for (int quantum = quantumAt(bracket.a); quantum <= quantumAt(bracket.b); quantum++) {
+            step.push_back({bracket.switchTime, quantum});
+        }
+    }
+    evaluate(pool, step, processes.size());
+    
+    return bestPerSwitchTime();
+}
+
+std::vector<QuantumEvaluation> QuantumTuner::successiveHalving(ThreadPool& pool) {
+    // Every switch time keeps its own survivors; a round runs them all at once
+    std::vector<int> grid = logGrid(spec.minQuantum, spec.maxQuantum, spec.candidates);
+    std::vector<std::vector<int>> survivors(switchTimes.size(), grid);
+    
+    // Budgets double each round and the last round simulates the whole workload.
+    // A prefix could cut a dependency chain, so jobs with after= always run whole.
+    bool dependencies = std::any_of(processes.begin(), processes.end(),
+                                    [](const std::shared_ptr<Process>& process) { return process->hasPredecessors(); });
+    int rounds = 0;
+    while ((static_cast<size_t>(1) << rounds) < grid.size()) {
+        rounds++;
+    }
+    
+    for (int round = 0; survivors.front().size() > 1; round++) {
+        size_t prefix = processes.size() >> std::max(rounds - 1 - round, 0);
+        if (dependencies || survivors.front().size() <= 2) {
+            prefix = processes.size();
+        }
+        prefix = std::min(processes.size(), std::max(prefix, MIN_PREFIX));
+        
+        std::vector<TuningPoint> step;
+        for (size_t s = 0; s < switchTimes.size(); s++) {
+            for (int quantum : survivors[s]) {
+                step.push_back({switchTimes[s], quantum});
+            }
+        }
+        std::vector<QuantumEvaluation> results = evaluate(pool, step, prefix);
+        
+        size_t offset = 0;
+        for (auto& group : survivors) {
+            std::vector<size_t> order(group.size());
+            for (size_t i = 0; i < order.size(); i++) {
+                order[i] = offset + i;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [&results](size_t x, size_t y) { return better(results[x], results[y]); });
+            
+            std::vector<int> next;
+            for (size_t i = 0; i < (group.size() + 1) / 2; i++) {
+                next.push_back(group[order[i] - offset]);
+            }
+            std::sort(next.begin(), next.end());
+            offset += group.size();
+            group = next;
+        }
+    }
+    
+    std::vector<TuningPoint> finals;
+    for (size_t s = 0; s < switchTimes.size(); s++) {
+        finals.push_back({switchTimes[s], survivors[s].front()});
+    }
+    return evaluate(pool, finals, processes.size());
+}
+
+bool QuantumTuner::run() {
+    if (processes.empty()) {
+        std::cerr << "Error: Nothing to tune, the workload has no processes" << std::endl;
+        return false;
+    }
+    
+    std::vector<QuantumEvaluation> bestPerSwitch;
+    std::vector<QuantumEvaluation> handPicked;
+    size_t threads = 0;
+    size_t searchSteps = 0;
+    {
+        ThreadPool pool(params.threads);
+        threads = pool.getThreadCount();
+        bestPerSwitch = spec.method == TuningMethod::GOLDEN ? goldenSection(pool) : successiveHalving(pool);
+        searchSteps = trace.size();
+        
+        // Runs for the comparison are not part of the search
+        std::vector<TuningPoint> points;
+        for (int switchTime : switchTimes) {
+            for (int quantum : HAND_PICKED_QUANTA) {
+                points.push_back({switchTime, quantum});
+            }
+        }
+        handPicked = evaluate(pool, points, processes.size());
+    }
+    QuantumEvaluation best = bestPerSwitch.front();
+    for (const auto& evaluation : bestPerSwitch) {
+        if (better(evaluation, best)) {
+            best = evaluation;
+        }
+    }
+    
+    std::cout << "Round Robin quantum tuning: minimize " << spec.objectiveName() << std::fixed
+              << std::setprecision(2);
+    if (spec.minUtilization > 0.0) {
+        std::cout << " subject to CPU utilization >= " << spec.minUtilization << "%";
+    }
+    std::cout << "\n"
+              << "Search: " << (spec.method == TuningMethod::GOLDEN ? "golden-section" : "successive halving")
+              << " over quanta " << spec.minQuantum << ".." << spec.maxQuantum << " and switch time";
+    for (size_t s = 0; s < switchTimes.size(); s++) {
+        std::cout << (s == 0 ? (switchTimes.size() == 1 ? " " : "s ") : ", ") << switchTimes[s];
+    }
+    std::cout << ", " << processes.size() << " processes, switch cost "
+              << SwitchCostModel::create(params.switchCostSpec)->describe() << ", " << threads
+              << (threads == 1 ? " thread\n\n" : " threads\n\n");
+    
+    std::cout << "Search Trace:\n"
+              << "  Step  Switch  Quantum  Processes    Objective  Utilization  Switches  Switch Overhead\n";
+    for (size_t i = 0; i < searchSteps; i++) {
+        const QuantumEvaluation& step = trace[i];
+        std::cout << std::setw(6) << i + 1 << std::setw(8) << step.switchTime << std::setw(9) << step.quantum
+                  << std::setw(11) << step.processes << std::setw(13) << step.objective << std::setw(12)
+                  << step.utilization << "%" << std::setw(10) << step.contextSwitches << std::setw(17)
+                  << step.switchOverhead << (step.feasible ? "" : "  (infeasible)") << "\n";
+    }
+    
+    std::cout << "\nHand-picked Quanta:\n";
+    for (const auto& evaluation : handPicked) {
+        std::cout << "  RR" << evaluation.quantum;
+        if (switchTimes.size() > 1) {
+            std::cout << " (switch time " << evaluation.switchTime << ")";
+        }
+        std::cout << ": " << spec.objectiveName() << " " << evaluation.objective << ", CPU utilization "
+                  << evaluation.utilization << "%" << (evaluation.feasible ? "" : " (infeasible)") << "\n";
+    }
+    
+    // A cheaper switch always helps, so how the best quantum moves with it is the useful part
+    if (switchTimes.size() > 1) {
+        std::cout << "\nBest Quantum per Switch Time:\n"
+                  << "  Switch  Quantum    Objective  Utilization  Switches  Switch Overhead\n";
+        for (const auto& evaluation : bestPerSwitch) {
+            std::cout << std::setw(8) << evaluation.switchTime << std::setw(9) << evaluation.quantum
+                      << std::setw(13) << evaluation.objective << std::setw(12) << evaluation.utilization << "%"
+                      << std::setw(10) << evaluation.contextSwitches << std::setw(17) << evaluation.switchOverhead
+                      << (evaluation.feasible ? "" : "  (infeasible)") << "\n";
+        }
+    }
+    
+    if (!best.feasible) {
+        std::cout << "\nNo quantum in " << spec.minQuantum << ".." << spec.maxQuantum << " reaches "
+                  << spec.minUtilization << "% CPU utilization (best " << best.utilization << "% at quantum "
+                  << best.quantum << ", switch time " << best.switchTime << ")\n";
+        return true;
+    }
+    std::cout << "\nBest Quantum: " << best.quantum << "\n"
+              << "  Switch Time: " << best.switchTime << "\n"
+              << "  " << spec.objectiveName() << ": " << best.objective << "\n"
+              << "  CPU Utilization: " << best.utilization << "%\n"
+              << "  Total Time: " << best.totalTime << " time units\n"
+              << "  Context Switches: " << best.contextSwitches << " (" << best.switchOverhead
+              << " time units switching)\n"
+              << "  Simulations: " << searchSteps << "\n";
+    return true;
+}
@@ -0,0 +1,102 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "cgroup.h"
+#include "process.h"
+#include "simulator.h"
+
+class ThreadPool;
+
+// Search strategies of the quantum tuner
+enum class TuningMethod {
+    GOLDEN,      // Parallel log-spaced grid, then golden-section search around the best point
+    HALVING      // Successive halving: all candidates on a short prefix, the best half on twice as much
+};
+
+// What the tuner minimizes and under which constraint, parsed from
+// "objective[,util=U][,range=min:max][,switch=S1:S2:...][,method=golden|halving][,candidates=N]".
+// Objectives are mean-, max- or pNN- (1..99) followed by turnaround or
+// waiting, e.g. p99-turnaround; util is the least CPU utilization (percent)
+// a setting must reach, so quanta short enough to drown in switches lose.
+// switch lists the context switch times to search the quantum under.
+struct TuningSpec {
+    std::string metric;          // "turnaround" or "waiting"
+    int percentile;              // 0 = mean, 100 = maximum
+    double minUtilization;
+    int minQuantum;
+    int maxQuantum;
+    std::vector<int> switchTimes;    // Ascending (empty = the input's switch time)
+    TuningMethod method;
+    int candidates;              // Starting candidates of successive halving
+    
+    TuningSpec()
+        : metric("turnaround"), percentile(0), minUtilization(0.0), minQuantum(1), maxQuantum(1000),
+          method(TuningMethod::GOLDEN), candidates(32) {}
+    
+    bool parse(const std::string& text);
+    std::string objectiveName() const;
+};
+
+// Outcome of one Round Robin run at a given quantum and switch time
+struct QuantumEvaluation {
+    int quantum = 0;
+    int switchTime = 0;
+    size_t processes = 0;        // Size of the workload prefix simulated
+    double objective = 0.0;
+    double utilization = 0.0;
+    int contextSwitches = 0;
+    long long switchOverhead = 0;
+    int totalTime = 0;
+    bool feasible = false;
+};
+
+// Quantum search for Round Robin on one parsed workload, over (switch time,
+// quantum) pairs: the quantum is searched under every switch time, whose
+// searches advance together. Every candidate is a full run on copies of the
+// shared processes, and candidates of a search step run in parallel on the
+// thread pool. A cheaper switch always wins, so besides the best pair the
+// report gives the best quantum per switch time; it also prints the search
+// trace and the hand-picked quanta (RR10, RR50, RR100) for comparison.
+class QuantumTuner {
+private:
+    using TuningPoint = std::pair<int, int>;          // (switch time, quantum)
+    
+    SimulationParams params;
+    TuningSpec spec;
+    std::vector<std::shared_ptr<Process>> processes;
+    std::vector<int> switchTimes;
+    std::shared_ptr<const CgroupHierarchy> cgroups;
+    MemoryConfig memoryConfig;
+    
+    std::vector<size_t> arrivalOrder;                 // Process indices by arrival time
+    std::map<TuningPoint, QuantumEvaluation> fullRuns;    // Runs on the whole workload
+    std::vector<QuantumEvaluation> trace;             // Every evaluation, in search order
+    
+    QuantumEvaluation simulate(const TuningPoint& point, size_t prefix) const;
+    std::vector<QuantumEvaluation> evaluate(ThreadPool& pool, const std::vector<TuningPoint>& points, size_t prefix);
+    
+    // Best quantum of every switch time, in switchTimes order
+    std::vector<QuantumEvaluation> goldenSection(ThreadPool& pool);
+    std::vector<QuantumEvaluation> successiveHalving(ThreadPool& pool);
+    std::vector<QuantumEvaluation> bestPerSwitchTime() const;
+    
+    std::vector<int> logGrid(int low, int high, int points) const;
+    
+public:
+    QuantumTuner(const SimulationParams& simulationParams, const TuningSpec& tuningSpec,
+                 const std::vector<std::shared_ptr<Process>>& workload, int switchTime,
+                 std::shared_ptr<const CgroupHierarchy> hierarchy, const MemoryConfig& memory);
+    
+    // True if a ranks before b: feasible settings first, then the lower
+    // objective; among infeasible ones the higher utilization
+    static bool better(const QuantumEvaluation& a, const QuantumEvaluation& b);
+    
+    bool run();
+};
+
+#endif // TUNER_H
@@ -0,0 +1,194 @@
+#include "workloadgen.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <sstream>
+
+bool GeneratorSpec::parse(const std::string& text) {
+    std::stringstream ss(text);
+    std::string item;
+    
+    while (std::getline(ss, item, ',')) {
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) {
+            std::cerr << "Error: Invalid spec entry '" << item << "' (expected key=value)" << std::endl;
+            return false;
+        }
+        
+        std::string key = item.substr(0, eq);
+        std::string value = item.substr(eq + 1);
+        
+        // Ranges are written min:max; both ends must be whole numbers
+        const char* start = value.c_str();
+        char* end = nullptr;
+        long low = std::strtol(start, &end, 10);
+        bool valid = end != start;
+        long high = low;
+        bool range = *end == ':';
+        if (range) {
+            start = end + 1;
+            high = std::strtol(start, &end, 10);
+            valid = valid && end != start;
+        }
+        bool rangeKey = key == "cpu" || key == "io" || key == "priority";
+        if (!valid || *end != '\0' || (range && !rangeKey) ||
+            low < INT_MIN || low > INT_MAX || high < INT_MIN || high > INT_MAX) {
+            std::cerr << "Error: Invalid spec entry '" << item << "'" << std::endl;
+            return false;
+        }
+        
+        if (key == "processes") {
+            numProcesses = low;
+        } else if (key == "switch") {
+            contextSwitchTime = low;
+        } else if (key == "arrival") {
+            meanArrivalInterval = low;
+        } else if (key == "bursts") {
+            meanCPUBursts = low;
+        } else if (key == "cpu") {
+            minCPUBurst = low;
+            maxCPUBurst = high;
+        } else if (key == "io") {
+            minIOBurst = low;
+            maxIOBurst = high;
+        } else if (key == "priority") {
+            minPriority = low;
+            maxPriority = high;
+        } else {
+            std::cerr << "Error: Unknown spec key '" << key << "'" << std::endl;
+            return false;
+        }
+    }
+    
+    if (numProcesses <= 0 || contextSwitchTime < 0 || meanArrivalInterval <= 0 || meanCPUBursts <= 0 ||
+        minCPUBurst <= 0 || maxCPUBurst < minCPUBurst || minIOBurst <= 0 || maxIOBurst < minIOBurst ||
+        minPriority < 0 || maxPriority < minPriority || maxPriority >= PRIORITY_LEVELS) {
+        std::cerr << "Error: Invalid generator spec '" << text << "'" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+std::string GeneratorSpec::toString() const {
+    std::stringstream ss;
+    ss << "processes=" << numProcesses << ",switch=" << contextSwitchTime
+       << ",arrival=" << meanArrivalInterval << ",bursts=" << meanCPUBursts
+       << ",cpu=" << minCPUBurst << ":" << maxCPUBurst
+       << ",io=" << minIOBurst << ":" << maxIOBurst
+       << ",priority=" << minPriority << ":" << maxPriority;
+    return ss.str();
+}
+
+WorkloadGenerator::WorkloadGenerator(const GeneratorSpec& generatorSpec, unsigned long long seed)
+    : spec(generatorSpec), gen(seed),
+      burstCountDist(spec.meanCPUBursts),
+      cpuBurstDist(spec.minCPUBurst, spec.maxCPUBurst),
+      ioBurstDist(spec.minIOBurst, spec.maxIOBurst),
+      priorityDist(spec.minPriority, spec.maxPriority) {
+}
+
+unsigned long long WorkloadGenerator::replicationSeed(unsigned long long baseSeed, unsigned long long replication) {
+    // splitmix64 step: well-spread, independent seeds from consecutive indices
+    unsigned long long z = baseSeed + (replication + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+std::shared_ptr<Process> WorkloadGenerator::generateJob(int pid, int arrivalTime) {
+    auto process = std::make_shared<Process>(pid, arrivalTime);
+    
+    // Only draw priorities for a real range, so other workloads keep their random stream
+    if (spec.minPriority < spec.maxPriority) {
+        process->setPriority(priorityDist(gen));
+    } else {
+        process->setPriority(spec.minPriority);
+    }
+    
+    // Generate number of CPU bursts (Poisson distribution, at least 1)
+    int numBursts = std::max(1, static_cast<int>(burstCountDist(gen)));
+    
+    // Generate CPU and I/O bursts (no I/O after the last CPU burst)
+    for (int j = 0; j < numBursts; j++) {
+        process->addCPUBurst(cpuBurstDist(gen));
+        
+        if (j < numBursts - 1) {
+            process->addIOBurst(ioBurstDist(gen));
+        }
+    }
+    
+    return process;
+}
+
+std::vector<std::shared_ptr<Process>> WorkloadGenerator::generate() {
+    std::exponential_distribution<> arrivalDist(1.0 / spec.meanArrivalInterval);
+    
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(spec.numProcesses);
+    
+    // First process always starts at time 0
+    int currentArrivalTime = 0;
+    
+    for (int i = 0; i < spec.numProcesses; i++) {
+        if (i > 0) {
+            // Calculate arrival time (exponential distribution)
+            currentArrivalTime += static_cast<int>(arrivalDist(gen));
+        }
+        processes.push_back(generateJob(i + 1, currentArrivalTime));
+    }
+    
+    return processes;
+}
+
+void WorkloadGenerator::write(std::ostream& out, const std::vector<std::shared_ptr<Process>>& processes,
+                              int contextSwitchTime) {
+    out << processes.size() << " " << contextSwitchTime << "\n";
+    
+    for (const auto& process : processes) {
+        const auto& bursts = process->getBursts();
+        int cpuBursts = (process->getTotalBursts() + 1) / 2;
+        
+        out << process->getId() << " " << process->getArrivalTime() << " " << cpuBursts;
+        if (process->getPriority() != DEFAULT_PRIORITY) {
+            out << " priority=" << process->getPriority();
+        }
+        if (process->getTickets() != DEFAULT_TICKETS) {
+            out << " tickets=" << process->getTickets();
+        }
+        if (process->getMemoryNode() >= 0) {
+            out << " node=" << process->getMemoryNode();
+        }
+        if (process->getMemorySize() > 0) {
+            out << " memory=" << process->getMemorySize();
+        }
+        if (process->getGroup() >= 0) {
+            out << " group=" << process->getGroup();
+        }
+        for (int pid : process->getPredecessors()) {
+            out << " after=" << pid;
+        }
+        
+        // Procedural processes are written as their behavior phases
+        if (auto behavior = process->getBehavior()) {
+            out << " behavior=" << behavior->getPhases().size() << " seed=" << behavior->getSeed() << "\n";
+            for (const auto& phase : behavior->getPhases()) {
+                out << phase.length << " " << phase.minCPU << " " << phase.maxCPU << " "
+                    << phase.minIO << " " << phase.maxIO << "\n";
+            }
+            continue;
+        }
+        out << "\n";
+        
+        int burstNumber = 1;
+        for (size_t i = 0; i < bursts.size(); i++) {
+            if (bursts[i].type != BurstType::CPU) continue;
+            
+            out << burstNumber++ << " " << bursts[i].duration;
+            if (i + 1 < bursts.size() && bursts[i + 1].type == BurstType::IO) {
+                out << " " << bursts[i + 1].duration;
+            }
+            out << "\n";
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef WORKLOADGEN_H
+#define WORKLOADGEN_H
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "process.h"
+
+// Distribution spec for random workloads
+// Arrival gaps are exponential, burst counts Poisson (at least 1), CPU and
+// I/O burst lengths and static priorities uniform. Parsed from "key=value"
+// pairs separated by commas, e.g. "processes=200,arrival=20,cpu=5:100".
+struct GeneratorSpec {
+    int numProcesses;
+    int contextSwitchTime;
+    int meanArrivalInterval;
+    int meanCPUBursts;
+    int minCPUBurst;
+    int maxCPUBurst;
+    int minIOBurst;
+    int maxIOBurst;
+    int minPriority;
+    int maxPriority;
+    
+    GeneratorSpec()
+        : numProcesses(50), contextSwitchTime(5), meanArrivalInterval(50), meanCPUBursts(20),
+          minCPUBurst(5), maxCPUBurst(500), minIOBurst(30), maxIOBurst(1000),
+          minPriority(DEFAULT_PRIORITY), maxPriority(DEFAULT_PRIORITY) {}
+    
+    bool parse(const std::string& text);
+    std::string toString() const;
+};
+
+// Random workload generator
+class WorkloadGenerator {
+private:
+    GeneratorSpec spec;
+    std::mt19937_64 gen;
+    std::poisson_distribution<> burstCountDist;
+    std::uniform_int_distribution<> cpuBurstDist;
+    std::uniform_int_distribution<> ioBurstDist;
+    std::uniform_int_distribution<> priorityDist;
+    
+public:
+    WorkloadGenerator(const GeneratorSpec& generatorSpec, unsigned long long seed);
+    
+    // Seed of the r-th independent replication derived from a base seed
+    static unsigned long long replicationSeed(unsigned long long baseSeed, unsigned long long replication);
+    
+    // Generate one workload directly in memory
+    std::vector<std::shared_ptr<Process>> generate();
+    
+    // Draw a single process (priority and bursts) from the spec, continuing
+    // the random stream; used by closed-loop clients
+    std::shared_ptr<Process> generateJob(int pid, int arrivalTime);
+    
+    // Write a workload in the simulator's input format
+    static void write(std::ostream& out, const std::vector<std::shared_ptr<Process>>& processes,
+                      int contextSwitchTime);
+};
+
+#endif // WORKLOADGEN_H